@@ -0,0 +1,30 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+namespace Benchmark
+{
+    // 10k items in nested linear boxes and in a grid box
+    bool runLayouts();
+
+    // independent panels, serial and concurrent, with comparing the results
+    bool runConcurrentLayouts();
+
+    // clip nodes of scroll areas with square viewports
+    bool runClipping();
+
+    // event throughput with and without an application wide filter
+    bool runEvents();
+
+    // typed skin hint accessors, with and without running animators
+    bool runHints();
+
+    // local hints of 10k controls with the same style
+    bool runHintTables();
+}
+
+#endif
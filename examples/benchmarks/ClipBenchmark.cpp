@@ -0,0 +1,165 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QskWindow.h>
+#include <QskScrollArea.h>
+#include <QskGridBox.h>
+#include <QskLinearBox.h>
+#include <QskBox.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskBoxBorderMetrics.h>
+#include <QskBoxClipNode.h>
+
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QDebug>
+
+static const int areaDimension = 6;
+static const int frameCount = 200;
+
+namespace
+{
+    struct ViewportStyle
+    {
+        const char* name;
+        qreal radius;
+        qreal borderWidth;
+    };
+
+    /*
+        The inner area of a rounded box becomes a rectangle, when the
+        border is wider than the radius. Then a scissor clip is used,
+        where a stencil pass had been necessary before. Rectangles
+        have always been clipped with the scissor test.
+
+        The second style looks almost the same, but its inner corners
+        are rounded and still need a stencil pass, as all rounded
+        clips did before.
+     */
+    const ViewportStyle viewportStyles[] =
+    {
+        { "Radius < border (scissor)", 4.0, 5.0 },
+        { "Radius > border (stencil)", 6.0, 5.0 }
+    };
+}
+
+static QskScrollArea* createScrollArea( const ViewportStyle& style )
+{
+    auto scrollArea = new QskScrollArea();
+
+    scrollArea->setBoxShapeHint( QskScrollView::Viewport,
+        QskBoxShapeMetrics( style.radius ) );
+
+    scrollArea->setBoxBorderMetricsHint( QskScrollView::Viewport,
+        QskBoxBorderMetrics( style.borderWidth ) );
+
+    auto box = new QskLinearBox( Qt::Vertical );
+
+    for ( int i = 0; i < 50; i++ )
+    {
+        auto child = new QskBox();
+        child->setBackgroundColor( ( i % 2 ) ? Qt::darkGray : Qt::lightGray );
+        child->setPreferredSize( 200, 20 );
+
+        box->addItem( child );
+    }
+
+    scrollArea->setScrolledItem( box );
+
+    return scrollArea;
+}
+
+static bool runStyle( const ViewportStyle& style )
+{
+    auto gridBox = new QskGridBox();
+
+    QVector< QskScrollArea* > scrollAreas;
+
+    for ( int i = 0; i < areaDimension * areaDimension; i++ )
+    {
+        auto scrollArea = createScrollArea( style );
+        gridBox->addItem( scrollArea, i / areaDimension, i % areaDimension );
+
+        scrollAreas += scrollArea;
+    }
+
+    // square viewports
+    QskWindow window;
+    window.resize( 800, 800 );
+    window.addItem( gridBox );
+
+    // not being limited by the refresh rate
+    auto format = window.format();
+    format.setSwapInterval( 0 );
+    window.setFormat( format );
+
+    QEventLoop loop;
+
+    QElapsedTimer timer;
+    int frames = 0;
+
+    QObject::connect( &window, &QQuickWindow::frameSwapped, &loop,
+        [&]()
+        {
+            if ( frames++ == 0 )
+                timer.start();
+
+            if ( frames > frameCount )
+            {
+                loop.quit();
+                return;
+            }
+
+            for ( auto scrollArea : qskAsConst( scrollAreas ) )
+                scrollArea->setScrollPos( QPointF( 0, frames % 100 ) );
+        } );
+
+    QTimer::singleShot( 30000, &loop, &QEventLoop::quit );
+
+    window.show();
+    loop.exec();
+
+    if ( frames <= frameCount )
+    {
+        qWarning() << style.name << "Rendered frames:" << frames;
+        return false;
+    }
+
+    qDebug() << style.name <<
+        "Frame:" << timer.nsecsElapsed() / ( 1e6 * frameCount ) << "(ms)";
+
+#ifdef ITEM_STATISTICS
+    const int clipCount = QskBoxClipNode::nodeCount();
+    const int stencilCount = QskBoxClipNode::stencilNodeCount();
+
+    qDebug() << style.name <<
+        "Scissor clips:" << clipCount - stencilCount <<
+        "Stencil clips:" << stencilCount;
+#endif
+
+    return true;
+}
+
+bool Benchmark::runClipping()
+{
+    /*
+        Each stencil clip costs a stencil pass per frame and prevents
+        batching the clipped nodes. The number of batches is reported
+        from Qt, when setting QSG_RENDERER_DEBUG=render.
+     */
+
+    bool ok = true;
+
+    for ( const auto& style : viewportStyles )
+    {
+        if ( !runStyle( style ) )
+            ok = false;
+    }
+
+    return ok;
+}
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+#include "LayoutTree.h"
+
+#include <QskControl.h>
+
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QDebug>
+
+static const int panelCount = 16;
+static const int panelDimension = 25;
+
+static const int passCount = 20;
+
+static QQuickItem* createPanels( bool concurrent )
+{
+    auto box = new LinearBox( Qt::Horizontal );
+    box->setDimension( 4 );
+    box->setControlFlag( QskControl::ConcurrentLayout, concurrent );
+
+    for ( int i = 0; i < panelCount; i++ )
+    {
+        auto panel = new GridBox();
+
+        for ( int row = 0; row < panelDimension; row++ )
+        {
+            for ( int col = 0; col < panelDimension; col++ )
+            {
+                auto item = new QskControl();
+                item->setPreferredSize( 5 + ( row * col + i ) % 7, 5 + ( row + col ) % 3 );
+
+                panel->addItem( item, row, col );
+            }
+        }
+
+        box->addItem( panel );
+    }
+
+    return box;
+}
+
+static inline QSizeF layoutSize( int pass )
+{
+    return QSizeF( 1600 + 40 * ( pass % 5 ), 1200 - 30 * ( pass % 4 ) );
+}
+
+static qint64 layoutPasses( QQuickItem* layout )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < passCount; i++ )
+    {
+        layout->setSize( layoutSize( i ) );
+        LayoutTree::layout( layout );
+    }
+
+    return timer.nsecsElapsed();
+}
+
+static bool isEqual( const QVector< QQuickItem* >& items1,
+    const QVector< QQuickItem* >& items2 )
+{
+    if ( items1.count() != items2.count() )
+        return false;
+
+    for ( int i = 0; i < items1.count(); i++ )
+    {
+        const auto item1 = items1[ i ];
+        const auto item2 = items2[ i ];
+
+        if ( item1->position() != item2->position()
+            || item1->size() != item2->size() )
+        {
+            qWarning() << "Geometries differ:" << i
+                << QRectF( item1->position(), item1->size() )
+                << QRectF( item2->position(), item2->size() );
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Benchmark::runConcurrentLayouts()
+{
+    auto serialLayout = createPanels( false );
+    auto concurrentLayout = createPanels( true );
+
+    const auto serialItems = LayoutTree::leafItems( serialLayout );
+    const auto concurrentItems = LayoutTree::leafItems( concurrentLayout );
+
+    // filling the caches
+    LayoutTree::layout( serialLayout );
+    LayoutTree::layout( concurrentLayout );
+
+    const double msSerial = layoutPasses( serialLayout ) / ( 1e6 * passCount );
+    const double msConcurrent = layoutPasses( concurrentLayout ) / ( 1e6 * passCount );
+
+    /*
+        The concurrent results have to be identical to the serial
+        ones - no matter in which order the tasks have been run.
+        So we compare the geometries for each size again.
+     */
+
+    bool isDeterministic = true;
+
+    for ( int i = 0; i < passCount && isDeterministic; i++ )
+    {
+        serialLayout->setSize( layoutSize( i ) );
+        LayoutTree::layout( serialLayout );
+
+        concurrentLayout->setSize( layoutSize( i ) );
+        LayoutTree::layout( concurrentLayout );
+
+        isDeterministic = isEqual( serialItems, concurrentItems );
+    }
+
+    qDebug() << "#Threads:" << QThreadPool::globalInstance()->maxThreadCount() <<
+        "#Panels:" << panelCount <<
+        "#Items:" << serialItems.count() <<
+        "Serial:" << msSerial <<
+        "Concurrent:" << msConcurrent << "(ms)" <<
+        "Deterministic:" << isDeterministic;
+
+    delete serialLayout;
+    delete concurrentLayout;
+
+    return isDeterministic;
+}
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QskControl.h>
+
+#include <QCoreApplication>
+#include <QMouseEvent>
+#include <QElapsedTimer>
+#include <QDebug>
+
+static const int sendCount = 1000000;
+static const int postCount = 100000;
+static const int mouseCount = 100000;
+
+namespace
+{
+    /*
+        The application wide filter, that has been installed before
+        the focus and wheel policies were moved into QskControl::event.
+        It is reduced to what every event had to pass.
+     */
+    class ApplicationFilter final : public QObject
+    {
+    public:
+        virtual bool eventFilter( QObject* object, QEvent* event ) override final
+        {
+            if ( auto control = qobject_cast< QskControl* >( object ) )
+            {
+                if ( event->type() == QEvent::Wheel && !control->isWheelEnabled() )
+                {
+                    event->ignore();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    };
+
+    class Receiver final : public QObject
+    {
+    public:
+        virtual bool event( QEvent* event ) override final
+        {
+            if ( event->type() == QEvent::User )
+                return true;
+
+            return QObject::event( event );
+        }
+    };
+}
+
+static inline double nsecsPerEvent( qint64 nsecs, int count )
+{
+    return double( nsecs ) / count;
+}
+
+static void measureEvents( const char* title )
+{
+    QElapsedTimer timer;
+
+    Receiver receiver;
+
+    timer.start();
+
+    for ( int i = 0; i < sendCount; i++ )
+    {
+        QEvent event( QEvent::User );
+        QCoreApplication::sendEvent( &receiver, &event );
+    }
+
+    const double nsSent = nsecsPerEvent( timer.nsecsElapsed(), sendCount );
+
+    timer.start();
+
+    for ( int i = 0; i < postCount; i++ )
+        QCoreApplication::postEvent( &receiver, new QEvent( QEvent::User ) );
+
+    QCoreApplication::sendPostedEvents( &receiver, QEvent::User );
+
+    const double nsPosted = nsecsPerEvent( timer.nsecsElapsed(), postCount );
+
+    QskControl control;
+    control.setSize( QSizeF( 100, 100 ) );
+
+    timer.start();
+
+    for ( int i = 0; i < mouseCount; i++ )
+    {
+        const QPointF pos( 50, 50 );
+
+        QMouseEvent pressEvent( QEvent::MouseButtonPress,
+            pos, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier );
+        QCoreApplication::sendEvent( &control, &pressEvent );
+
+        QMouseEvent releaseEvent( QEvent::MouseButtonRelease,
+            pos, Qt::LeftButton, Qt::NoButton, Qt::NoModifier );
+        QCoreApplication::sendEvent( &control, &releaseEvent );
+    }
+
+    const double nsMouse = nsecsPerEvent( timer.nsecsElapsed(), 2 * mouseCount );
+
+    qDebug() << title <<
+        "Sent:" << nsSent <<
+        "Posted:" << nsPosted <<
+        "Mouse:" << nsMouse << "(ns per event)";
+}
+
+bool Benchmark::runEvents()
+{
+    measureEvents( "Control dispatch" );
+
+    ApplicationFilter filter;
+    QCoreApplication::instance()->installEventFilter( &filter );
+
+    measureEvents( "Application filter" );
+
+    QCoreApplication::instance()->removeEventFilter( &filter );
+
+    return true;
+}
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QskWindow.h>
+#include <QskPushButton.h>
+#include <QskAspect.h>
+#include <QskAnimationHint.h>
+#include <QskMargins.h>
+#include <QskBoxShapeMetrics.h>
+
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QDebug>
+
+static const int callCount = 1000000;
+
+template< typename Function >
+static double nsecsPerCall( Function function )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < callCount; i++ )
+        function();
+
+    return double( timer.nsecsElapsed() ) / callCount;
+}
+
+static void measureHints( const char* title, const QskPushButton& button )
+{
+    using namespace QskAspect;
+    using Q = QskPushButton;
+
+    /*
+        effectiveHint and the typed accessors share the same lookup.
+        The first column measures the additional QVariant copy, that
+        the typed accessors did before they were specialized for
+        the type of the hint - not the lookup of the animators.
+     */
+
+    const auto colorAspect = Q::Text | Color;
+    const auto metricAspect = Q::Panel | Metric | Size;
+    const auto marginsAspect = Q::Panel | Metric | Padding;
+    const auto shapeAspect = Q::Panel | Metric | Shape;
+
+    const double nsColor[] =
+    {
+        nsecsPerCall( [&]() { return button.effectiveHint( colorAspect ).value< QColor >(); } ),
+        nsecsPerCall( [&]() { return button.color( Q::Text ); } )
+    };
+
+    const double nsMetric[] =
+    {
+        nsecsPerCall( [&]() { return button.effectiveHint( metricAspect ).toReal(); } ),
+        nsecsPerCall( [&]() { return button.metric( Q::Panel | Size ); } )
+    };
+
+    const double nsMargins[] =
+    {
+        nsecsPerCall( [&]() { return button.effectiveHint( marginsAspect ).value< QskMargins >(); } ),
+        nsecsPerCall( [&]() { return button.marginsHint( Q::Panel | Padding ); } )
+    };
+
+    const double nsShape[] =
+    {
+        nsecsPerCall( [&]()
+            { return button.effectiveHint( shapeAspect ).value< QskBoxShapeMetrics >(); } ),
+        nsecsPerCall( [&]() { return button.boxShapeHint( Q::Panel ); } )
+    };
+
+    qDebug() << title << "QVariant copy/typed (ns per call)" <<
+        "Color:" << nsColor[ 0 ] << nsColor[ 1 ] <<
+        "Metric:" << nsMetric[ 0 ] << nsMetric[ 1 ] <<
+        "Margins:" << nsMargins[ 0 ] << nsMargins[ 1 ] <<
+        "Shape:" << nsShape[ 0 ] << nsShape[ 1 ];
+}
+
+bool Benchmark::runHints()
+{
+    using namespace QskAspect;
+    using Q = QskPushButton;
+
+    QskPushButton button;
+    measureHints( "Skin hints", button );
+
+    // the lookups have to check the local table first
+    button.setColor( Q::Text, Qt::red );
+    button.setMetric( Q::Panel | Size, 20 );
+    button.setMarginsHint( Q::Panel | Padding, 5 );
+    button.setBoxShapeHint( Q::Panel, QskBoxShapeMetrics( 5 ) );
+
+    measureHints( "Local hints", button );
+
+    /*
+        Without running animators the accessors skip looking for
+        animated values. With an animator for an unrelated aspect
+        they walk the animator table first, what all lookups did
+        before. The difference to the previous lines is the cost
+        of this walk.
+     */
+
+    QskWindow window;
+    window.resize( 200, 200 );
+
+    // no QObject parent, as the button must not be deleted by the window
+    button.setParentItem( window.contentItem() );
+
+    QEventLoop loop;
+    QObject::connect( &window, &QQuickWindow::frameSwapped,
+        &loop, &QEventLoop::quit );
+
+    QTimer::singleShot( 10000, &loop, &QEventLoop::quit );
+
+    window.show();
+    loop.exec();
+
+    // animators are started for initially painted controls only
+    if ( !button.isInitiallyPainted() )
+    {
+        qWarning() << "The button has not been painted";
+        return false;
+    }
+
+    button.startTransition( Q::Panel | Color,
+        QskAnimationHint( 3600000 ), QColor( Qt::red ), QColor( Qt::blue ) );
+
+    measureHints( "Running animator", button );
+
+    button.setParentItem( nullptr );
+
+    return true;
+}
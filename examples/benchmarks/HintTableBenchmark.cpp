@@ -0,0 +1,147 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QskPushButton.h>
+#include <QskSkinHintTable.h>
+
+#include <QElapsedTimer>
+#include <QVector>
+#include <QDebug>
+
+#include <set>
+
+static const int controlCount = 10000;
+
+namespace
+{
+    class Button final : public QskPushButton
+    {
+    public:
+        const QskSkinHintTable& localHints() const
+        {
+            return hintTable();
+        }
+    };
+}
+
+static void setDangerHints( QskPushButton* button )
+{
+    using Q = QskPushButton;
+
+    button->setGradientHint( Q::Panel, QskGradient( Qt::red ) );
+    button->setBoxShapeHint( Q::Panel, QskBoxShapeMetrics( 4 ) );
+    button->setBoxBorderMetricsHint( Q::Panel, QskBoxBorderMetrics( 2 ) );
+    button->setBoxBorderColorsHint( Q::Panel, QskBoxBorderColors( Qt::darkRed ) );
+    button->setColor( Q::Text, Qt::white );
+}
+
+static QskSkinHintTable dangerHintTable()
+{
+    using Q = QskPushButton;
+
+    QskSkinHintTable table;
+
+    table.setGradient( Q::Panel, QskGradient( Qt::red ) );
+    table.setBoxShape( Q::Panel, QskBoxShapeMetrics( 4 ) );
+    table.setBoxBorder( Q::Panel, QskBoxBorderMetrics( 2 ) );
+    table.setBoxBorderColors( Q::Panel, QskBoxBorderColors( Qt::darkRed ) );
+    table.setColor( Q::Text, Qt::white );
+
+    return table;
+}
+
+static void measureButtons( const char* title, const QVector< Button* >& buttons,
+    double msCreated )
+{
+    using Q = QskPushButton;
+
+    /*
+        An estimation of the memory of the hash maps: nodes with the
+        aspect, the QVariant and a link, plus the buckets. The payloads
+        of the QVariants, that are not stored inside, are not included.
+     */
+    const size_t nodeSize = sizeof( void* )
+        + sizeof( QskAspect::Aspect ) + sizeof( QVariant );
+
+    std::set< const void* > maps;
+    size_t bytes = 0;
+
+    for ( auto button : buttons )
+    {
+        const auto& hints = button->localHints().hints();
+
+        if ( maps.insert( &hints ).second )
+            bytes += hints.size() * nodeSize + hints.bucket_count() * sizeof( void* );
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( auto button : buttons )
+    {
+        button->color( Q::Text );
+        button->boxShapeHint( Q::Panel );
+    }
+
+    const double nsLookup = double( timer.nsecsElapsed() ) / ( 2 * buttons.count() );
+
+    qDebug() << title << "#Controls:" << buttons.count() <<
+        "Created:" << msCreated << "(ms)" <<
+        "Hint maps:" << maps.size() <<
+        "Estimated bytes:" << bytes <<
+        "Lookup:" << nsLookup << "(ns)";
+}
+
+bool Benchmark::runHintTables()
+{
+    QElapsedTimer timer;
+
+    QVector< Button* > buttons;
+    buttons.reserve( controlCount );
+
+    {
+        // each control sets its local hints
+
+        timer.start();
+
+        for ( int i = 0; i < controlCount; i++ )
+        {
+            auto button = new Button();
+            setDangerHints( button );
+
+            buttons += button;
+        }
+
+        measureButtons( "Local hints", buttons, timer.nsecsElapsed() / 1e6 );
+
+        qDeleteAll( buttons );
+        buttons.clear();
+    }
+
+    {
+        // all controls share one prepared table
+
+        timer.start();
+
+        const auto table = dangerHintTable();
+
+        for ( int i = 0; i < controlCount; i++ )
+        {
+            auto button = new Button();
+            button->setHintTable( table );
+
+            buttons += button;
+        }
+
+        measureButtons( "Shared table", buttons, timer.nsecsElapsed() / 1e6 );
+
+        qDeleteAll( buttons );
+        buttons.clear();
+    }
+
+    return true;
+}
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+#include "LayoutTree.h"
+
+#include <QskControl.h>
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+static const int rowCount = 100;
+static const int columnCount = 100;
+
+static const int resizeCount = 20;
+static const int changeCount = 100;
+
+static inline double msecs( qint64 nsecs, int count = 1 )
+{
+    return nsecs / ( 1e6 * count );
+}
+
+static QskControl* createItem()
+{
+    auto item = new QskControl();
+    item->setPreferredSize( 10.0, 10.0 );
+
+    return item;
+}
+
+static QQuickItem* createLinearBoxes()
+{
+    auto box = new LinearBox( Qt::Vertical );
+
+    for ( int row = 0; row < rowCount; row++ )
+    {
+        auto rowBox = new LinearBox( Qt::Horizontal );
+
+        for ( int col = 0; col < columnCount; col++ )
+            rowBox->addItem( createItem() );
+
+        box->addItem( rowBox );
+    }
+
+    return box;
+}
+
+static QQuickItem* createGridBox()
+{
+    auto box = new GridBox();
+
+    for ( int row = 0; row < rowCount; row++ )
+    {
+        for ( int col = 0; col < columnCount; col++ )
+            box->addItem( createItem(), row, col );
+    }
+
+    return box;
+}
+
+static void runLayout( const char* title, QQuickItem* ( *createLayout )() )
+{
+    QElapsedTimer timer;
+
+    timer.start();
+
+    auto layout = createLayout();
+    const double msCreated = msecs( timer.nsecsElapsed() );
+
+    const auto items = LayoutTree::leafItems( layout );
+
+    {
+        // the first pass has to fill all caches
+
+        timer.start();
+
+        layout->setSize( QSizeF( 1000, 1000 ) );
+        LayoutTree::layout( layout );
+    }
+
+    const double msFirst = msecs( timer.nsecsElapsed() );
+
+    {
+        // the hints are unchanged, only the geometries are recalculated
+
+        timer.start();
+
+        for ( int i = 0; i < resizeCount; i++ )
+        {
+            layout->setSize( ( i % 2 ) ? QSizeF( 1200, 900 ) : QSizeF( 1000, 1000 ) );
+            LayoutTree::layout( layout );
+        }
+    }
+
+    const double msResized = msecs( timer.nsecsElapsed(), resizeCount );
+
+    {
+        // one item at a time changes its hints
+
+        timer.start();
+
+        for ( int i = 0; i < changeCount; i++ )
+        {
+            auto item = static_cast< QskControl* >(
+                items[ ( i * 997 ) % items.count() ] );
+
+            item->setPreferredSize( 11.0 + i % 3, 10.0 );
+            LayoutTree::layout( layout );
+        }
+    }
+
+    const double msChanged = msecs( timer.nsecsElapsed(), changeCount );
+
+    qDebug() << title << "#Items:" << items.count() <<
+        "Created:" << msCreated <<
+        "First layout:" << msFirst <<
+        "Resized:" << msResized <<
+        "Item changed:" << msChanged << "(ms)";
+
+    delete layout;
+}
+
+bool Benchmark::runLayouts()
+{
+    /*
+        Only the public API of the boxes is used, so the
+        numbers can be compared with previous versions
+        of the layout engine.
+     */
+    runLayout( "Nested linear boxes", createLinearBoxes );
+    runLayout( "Grid box", createGridBox );
+
+    return true;
+}
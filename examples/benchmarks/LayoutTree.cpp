@@ -0,0 +1,42 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "LayoutTree.h"
+
+static void collectLeafItems( QQuickItem* item, QVector< QQuickItem* >& items )
+{
+    if ( dynamic_cast< LinearBox* >( item ) || dynamic_cast< GridBox* >( item ) )
+    {
+        const auto children = item->childItems();
+        for ( auto child : children )
+            collectLeafItems( child, items );
+    }
+    else
+    {
+        items += item;
+    }
+}
+
+void LayoutTree::layout( QQuickItem* item )
+{
+    if ( auto linearBox = dynamic_cast< LinearBox* >( item ) )
+        linearBox->layoutNow();
+    else if ( auto gridBox = dynamic_cast< GridBox* >( item ) )
+        gridBox->layoutNow();
+    else
+        return;
+
+    const auto children = item->childItems();
+    for ( auto child : children )
+        layout( child );
+}
+
+QVector< QQuickItem* > LayoutTree::leafItems( QQuickItem* item )
+{
+    QVector< QQuickItem* > items;
+    collectLeafItems( item, items );
+
+    return items;
+}
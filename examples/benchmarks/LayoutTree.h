@@ -0,0 +1,57 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#ifndef LAYOUT_TREE_H
+#define LAYOUT_TREE_H
+
+#include <QskLinearBox.h>
+#include <QskGridBox.h>
+
+#include <QVector>
+
+/*
+    Layouts are usually updated, when the window polishes its items
+    before rendering. The benchmarks run the layout passes without
+    a window, so the boxes need to offer their updateLayout().
+ */
+
+class LinearBox : public QskLinearBox
+{
+public:
+    LinearBox( Qt::Orientation orientation, QQuickItem* parent = nullptr ):
+        QskLinearBox( orientation, parent )
+    {
+    }
+
+    void layoutNow()
+    {
+        updateLayout();
+    }
+};
+
+class GridBox : public QskGridBox
+{
+public:
+    GridBox( QQuickItem* parent = nullptr ):
+        QskGridBox( parent )
+    {
+    }
+
+    void layoutNow()
+    {
+        updateLayout();
+    }
+};
+
+namespace LayoutTree
+{
+    // lays out a box and all nested boxes, parents first
+    void layout( QQuickItem* );
+
+    // all items, that are no boxes, in depth first order
+    QVector< QQuickItem* > leafItems( QQuickItem* );
+}
+
+#endif
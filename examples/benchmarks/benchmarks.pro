@@ -0,0 +1,17 @@
+include( $${PWD}/../examples.pri )
+
+TARGET = benchmarks
+
+HEADERS += \
+    Benchmark.h \
+    LayoutTree.h
+
+SOURCES += \
+    ClipBenchmark.cpp \
+    ConcurrencyBenchmark.cpp \
+    EventBenchmark.cpp \
+    HintBenchmark.cpp \
+    HintTableBenchmark.cpp \
+    LayoutBenchmark.cpp \
+    LayoutTree.cpp \
+    main.cpp
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+namespace
+{
+    struct BenchmarkEntry
+    {
+        const char* name;
+        bool ( *run )();
+    };
+
+    const BenchmarkEntry benchmarks[] =
+    {
+        { "layouts", Benchmark::runLayouts },
+        { "concurrency", Benchmark::runConcurrentLayouts },
+        { "clipping", Benchmark::runClipping },
+        { "events", Benchmark::runEvents },
+        { "hints", Benchmark::runHints },
+        { "hinttables", Benchmark::runHintTables }
+    };
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QString names;
+    for ( const auto& benchmark : benchmarks )
+    {
+        if ( !names.isEmpty() )
+            names += ", ";
+
+        names += benchmark.name;
+    }
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarks for layouts, scene graph nodes and skin hints" );
+    parser.addHelpOption();
+    parser.addPositionalArgument( "benchmark",
+        "Benchmarks to run: " + names + ". All, when none is given.", "[benchmark...]" );
+
+    parser.process( app );
+
+    const QStringList args = parser.positionalArguments();
+
+    bool ok = true;
+
+    for ( const auto& benchmark : benchmarks )
+    {
+        if ( args.isEmpty() || args.contains( benchmark.name ) )
+        {
+            if ( !benchmark.run() )
+            {
+                qCritical() << "Benchmark failed:" << benchmark.name;
+                ok = false;
+            }
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -19,8 +19,10 @@
 #include <QskRgbValue.h>
 
 #include <QskObjectCounter.h>
+#include <QskBoxNode.h>
 
 #include <QGuiApplication>
+#include <QDebug>
 
 class Rectangle : public Box
 {
@@ -412,6 +414,39 @@ private:
     }
 };
 
+static void setupMaterialMode( const QStringList& arguments )
+{
+    /*
+        Comparing the material modes of QskBoxNode. The number
+        of batches is reported from Qt, when setting
+        QSG_RENDERER_DEBUG=render.
+     */
+
+    if ( arguments.contains( QStringLiteral( "--flat" ) ) )
+        QskBoxNode::setMaterialMode( QskBoxNode::FlatColorWhenMonochrome );
+    else if ( arguments.contains( QStringLiteral( "--auto" ) ) )
+        QskBoxNode::setMaterialMode( QskBoxNode::AutoMaterial );
+    else
+        QskBoxNode::setMaterialMode( QskBoxNode::VertexColorMaterial );
+
+    QskBoxNode::setCompactVertexes(
+        arguments.contains( QStringLiteral( "--compact" ) ) );
+}
+
+static void printBoxStatistics()
+{
+    const auto bytes = QskBoxNode::uploadedVertexBytes();
+    if ( bytes > 0 )
+    {
+        qDebug() << "Box nodes:" << QskBoxNode::nodeCount()
+            << "flat:" << QskBoxNode::flatColorNodeCount()
+            << "compact:" << QskBoxNode::compactNodeCount()
+            << "vertex bytes:" << bytes;
+
+        QskBoxNode::resetUploadedVertexBytes();
+    }
+}
+
 int main( int argc, char* argv[] )
 {
 #ifdef ITEM_STATISTICS
@@ -424,6 +459,8 @@ int main( int argc, char* argv[] )
     SkinnyShortcut::enable( SkinnyShortcut::Quit |
         SkinnyShortcut::DebugShortcuts );
 
+    setupMaterialMode( app.arguments() );
+
     auto* tabView = new TabView();
 
     QskWindow window;
@@ -431,5 +468,8 @@ int main( int argc, char* argv[] )
     window.resize( 600, 600 );
     window.show();
 
+    QObject::connect( &window, &QQuickWindow::frameSwapped,
+        &window, printBoxStatistics, Qt::DirectConnection );
+
     return app.exec();
 }
@@ -5,6 +5,7 @@ TEMPLATE = subdirs
 # c++
 SUBDIRS += \
     automotive \
+    benchmarks \
     qvgviewer \
     desktop \
     dialogbuttons \
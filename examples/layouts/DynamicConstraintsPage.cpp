@@ -7,10 +7,13 @@
 
 #include <QskAspect.h>
 #include <QskControl.h>
+#include <QskLayoutConstraint.h>
 #include <QskLinearBox.h>
 #include <QskPushButton.h>
 #include <QskRgbValue.h>
 
+#include <QDebug>
+
 namespace
 {
     class Control : public QskControl
@@ -105,6 +108,14 @@ Box::Box( QQuickItem* parent ):
 
 void Box::flip()
 {
+    // the constraint evaluations, that happened since the previous flip
+
+    qDebug() << "Constraints - evaluated:"
+        << QskLayoutConstraint::constraintEvaluations()
+        << "cached:" << QskLayoutConstraint::constraintCacheHits();
+
+    QskLayoutConstraint::resetConstraintCounters();
+
     setActive( false );
 
     for ( int i = 0; i < itemCount(); i++ )
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "VirtualLayoutPage.h"
+#include "TestRectangle.h"
+#include "ButtonBox.h"
+
+#include <QskRgbValue.h>
+#include <QskScrollArea.h>
+#include <QskVirtualBox.h>
+
+namespace
+{
+    class Box : public QskVirtualBox
+    {
+    public:
+        Box( QQuickItem* parent = nullptr ):
+            QskVirtualBox( Qt::Vertical, 5, parent )
+        {
+            setObjectName( "VirtualBox" );
+
+            setBackgroundColor( Qt::white );
+            setMargins( 10 );
+
+            setEstimatedItemSize( QSizeF( 80, 40 ) );
+            setCount( 50000 );
+        }
+
+        void incrementDimension( int count )
+        {
+            setDimension( dimension() + count );
+        }
+
+    protected:
+        virtual QQuickItem* createItem() override final
+        {
+            auto rectangle = new TestRectangle( "LightSteelBlue" );
+            rectangle->setPreferredHeight( 40 );
+
+            return rectangle;
+        }
+
+        virtual void updateItem( QQuickItem* item, int index ) override final
+        {
+            // only the entries inside of the viewport come here
+
+            static const char* colorNames[] =
+                { "LightSteelBlue", "PowderBlue", "LightBlue", "SkyBlue", "LightSkyBlue" };
+
+            auto rectangle = static_cast< TestRectangle* >( item );
+            rectangle->setBackgroundColor( colorNames[ index % 5 ] );
+            rectangle->setText( QString::number( index + 1 ) );
+        }
+    };
+}
+
+VirtualLayoutPage::VirtualLayoutPage( QQuickItem* parent ):
+    QskLinearBox( Qt::Vertical, parent )
+{
+    setMargins( 10 );
+    setBackgroundColor( QskRgbValue::LightSteelBlue );
+
+    Box* box = new Box();
+
+    QskScrollArea* scrollArea = new QskScrollArea();
+    scrollArea->setScrolledItem( box );
+
+    ButtonBox* buttonBox = new ButtonBox();
+    buttonBox->addButton( "Dim+", [ box ]() { box->incrementDimension( +1 ); } );
+    buttonBox->addButton( "Dim-", [ box ]() { box->incrementDimension( -1 ); } );
+
+    addItem( buttonBox, Qt::AlignTop | Qt::AlignLeft );
+    addItem( scrollArea );
+}
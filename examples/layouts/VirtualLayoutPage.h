@@ -0,0 +1,17 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#ifndef VIRTUAL_LAYOUT_PAGE
+#define VIRTUAL_LAYOUT_PAGE 1
+
+#include <QskLinearBox.h>
+
+class VirtualLayoutPage : public QskLinearBox
+{
+public:
+    VirtualLayoutPage( QQuickItem* parent = nullptr );
+};
+
+#endif
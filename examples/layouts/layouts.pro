@@ -10,7 +10,8 @@ HEADERS += \
     FlowLayoutPage.h \
     LinearLayoutPage.h \
     DynamicConstraintsPage.h \
-    StackLayoutPage.h
+    StackLayoutPage.h \
+    VirtualLayoutPage.h
 
 SOURCES += \
     TestRectangle.cpp \
@@ -19,4 +20,5 @@ SOURCES += \
     LinearLayoutPage.cpp \
     DynamicConstraintsPage.cpp \
     StackLayoutPage.cpp \
+    VirtualLayoutPage.cpp \
     main.cpp
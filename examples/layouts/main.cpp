@@ -7,6 +7,7 @@
 #include "LinearLayoutPage.h"
 #include "DynamicConstraintsPage.h"
 #include "StackLayoutPage.h"
+#include "VirtualLayoutPage.h"
 
 #include <SkinnyFont.h>
 #include <SkinnyShortcut.h>
@@ -67,6 +68,7 @@ int main( int argc, char* argv[] )
     button->setTextOptions( textOptions );
 
     tabView->addTab( "Stack Layout", new StackLayoutPage() );
+    tabView->addTab( "Virtual Layout", new VirtualLayoutPage() );
 
     tabView->setCurrentIndex( 4 );
 
@@ -148,9 +148,9 @@ int main( int argc, char* argv[] )
         The thumbnails are implemented as buttons, so that we can see if the gesture
         recognition for the flicking works without stopping the buttons from being functional. 
 
-        This example also shows, that blocking of the scene graph node creation
-        ( QskControl::DeferredUpdate + QskControl::CleanupOnVisibility ) 
-        could be improved to also respect being inside the window or a clip region.
+        Blocking of the scene graph node creation for the thumbnails, that are
+        outside of the window, can be enabled by QskControl::CullOutsideWindow.
+        Respecting a clip region is not implemented yet.
 
         But here we only want to demonstrate how QskScrollArea works.
      */
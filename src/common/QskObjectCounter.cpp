@@ -6,8 +6,14 @@
 #include "QskObjectCounter.h"
 #include <QQuickItem>
 #include <QSet>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
 #include <QDebug>
 
+#include <algorithm>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qhooks_p.h>
 #include <private/qquickitem_p.h>
@@ -28,6 +34,11 @@ static inline bool qskIsItem( const QObject* object )
     return dynamic_cast< QQuickItemPrivate* >( o_p ) != nullptr;
 }
 
+static const char* qskNodeTypeNames[] = { "Box", "Text", "Glyph", "Texture" };
+
+static QAtomicInt qskNodeCounts[ QskObjectCounter::NodeTypeCount ];
+static QAtomicInteger< qint64 > qskNodeBytes[ QskObjectCounter::NodeTypeCount ];
+
 static void qskStartupHook();
 static void qskAddObjectHook( QObject* );
 static void qskRemoveObjectHook( QObject* );
@@ -148,6 +159,64 @@ static void qskInstallCleanupHookHandler()
 
 Q_COREAPP_STARTUP_FUNCTION( qskInstallCleanupHookHandler )
 
+class QskObjectCounter::ClassData
+{
+public:
+    /*
+        The hooks are called from the constructor/destructor of QObject,
+        where the final class is not known. So we remember the objects
+        and resolve their classes later, when the objects have been
+        constructed. Objects, that are destroyed before, are not
+        included in the class statistics.
+     */
+    QHash< QObject*, const QMetaObject* > objects;
+    QHash< const QMetaObject*, Counter > classCounters;
+
+    // objects might be created in any thread
+    QMutex mutex;
+};
+
+QskObjectCounter::Snapshot::Snapshot():
+    objects( 0 ),
+    items( 0 )
+{
+    for ( int i = 0; i < NodeTypeCount; i++ )
+    {
+        nodes[ i ] = 0;
+        nodeBytes[ i ] = 0;
+    }
+}
+
+QskObjectCounter::Snapshot QskObjectCounter::Snapshot::diff(
+    const Snapshot& earlier ) const
+{
+    Snapshot snapshot;
+
+    snapshot.objects = objects - earlier.objects;
+    snapshot.items = items - earlier.items;
+
+    for ( int i = 0; i < NodeTypeCount; i++ )
+    {
+        snapshot.nodes[ i ] = nodes[ i ] - earlier.nodes[ i ];
+        snapshot.nodeBytes[ i ] = nodeBytes[ i ] - earlier.nodeBytes[ i ];
+    }
+
+    for ( auto it = classes.constBegin(); it != classes.constEnd(); ++it )
+    {
+        const int count = it.value() - earlier.classes.value( it.key() );
+        if ( count != 0 )
+            snapshot.classes.insert( it.key(), count );
+    }
+
+    for ( auto it = earlier.classes.constBegin(); it != earlier.classes.constEnd(); ++it )
+    {
+        if ( !classes.contains( it.key() ) && it.value() != 0 )
+            snapshot.classes.insert( it.key(), -it.value() );
+    }
+
+    return snapshot;
+}
+
 QskObjectCounter::QskObjectCounter( bool debugAtDestruction ):
     m_debugAtDestruction( debugAtDestruction )
 {
@@ -196,6 +265,12 @@ void QskObjectCounter::addObject( QObject* object )
 
     if ( qskIsItem( object ) )
         m_counter[Items].increment();
+
+    if ( m_classData )
+    {
+        QMutexLocker locker( &m_classData->mutex );
+        m_classData->objects.insert( object, nullptr );
+    }
 }
 
 void QskObjectCounter::removeObject( QObject* object )
@@ -204,12 +279,131 @@ void QskObjectCounter::removeObject( QObject* object )
 
     if ( qskIsItem( object ) )
         m_counter[Items].decrement();
+
+    if ( m_classData )
+    {
+        QMutexLocker locker( &m_classData->mutex );
+
+        auto it = m_classData->objects.find( object );
+        if ( it != m_classData->objects.end() )
+        {
+            if ( it.value() )
+                m_classData->classCounters[ it.value() ].decrement();
+
+            m_classData->objects.erase( it );
+        }
+    }
+}
+
+void QskObjectCounter::resolveClasses() const
+{
+    if ( m_classData == nullptr )
+        return;
+
+    QMutexLocker locker( &m_classData->mutex );
+
+    for ( auto it = m_classData->objects.begin();
+        it != m_classData->objects.end(); ++it )
+    {
+        if ( it.value() == nullptr )
+        {
+            const auto metaObject = it.key()->metaObject();
+
+            it.value() = metaObject;
+            m_classData->classCounters[ metaObject ].increment();
+        }
+    }
 }
 
 void QskObjectCounter::reset()
 {
     m_counter[Objects].reset();
     m_counter[Items].reset();
+
+    if ( m_classData )
+    {
+        // objects, that are alive, will be resolved again
+
+        QMutexLocker locker( &m_classData->mutex );
+
+        for ( auto it = m_classData->objects.begin();
+            it != m_classData->objects.end(); ++it )
+        {
+            it.value() = nullptr;
+        }
+
+        m_classData->classCounters.clear();
+    }
+}
+
+void QskObjectCounter::setClassAccounting( bool on )
+{
+    if ( on == hasClassAccounting() )
+        return;
+
+    /*
+        Objects, that have been created before, are unknown
+        and will never show up in the class statistics.
+     */
+    if ( on )
+        m_classData.reset( new ClassData() );
+    else
+        m_classData.reset();
+}
+
+bool QskObjectCounter::hasClassAccounting() const
+{
+    return m_classData != nullptr;
+}
+
+QskObjectCounter::Snapshot QskObjectCounter::snapshot() const
+{
+    Snapshot snapshot;
+
+    snapshot.objects = m_counter[Objects].current;
+    snapshot.items = m_counter[Items].current;
+
+    for ( int i = 0; i < NodeTypeCount; i++ )
+    {
+        snapshot.nodes[ i ] = qskNodeCounts[ i ].load();
+        snapshot.nodeBytes[ i ] = qskNodeBytes[ i ].load();
+    }
+
+    if ( m_classData )
+    {
+        resolveClasses();
+
+        QMutexLocker locker( &m_classData->mutex );
+
+        const auto& counters = m_classData->classCounters;
+        for ( auto it = counters.constBegin(); it != counters.constEnd(); ++it )
+        {
+            if ( it.value().current != 0 )
+                snapshot.classes.insert( it.key()->className(), it.value().current );
+        }
+    }
+
+    return snapshot;
+}
+
+int QskObjectCounter::nodeCount( NodeType nodeType )
+{
+    return qskNodeCounts[ nodeType ].load();
+}
+
+qint64 QskObjectCounter::estimatedNodeBytes( NodeType nodeType )
+{
+    return qskNodeBytes[ nodeType ].load();
+}
+
+void QskObjectCounter::countNode( NodeType nodeType, int delta )
+{
+    qskNodeCounts[ nodeType ].fetchAndAddRelaxed( delta );
+}
+
+void QskObjectCounter::countNodeBytes( NodeType nodeType, qint64 delta )
+{
+    qskNodeBytes[ nodeType ].fetchAndAddRelaxed( delta );
 }
 
 int QskObjectCounter::created( ObjectType objectType ) const
@@ -260,6 +454,34 @@ void QskObjectCounter::dump() const
 
     debug << "\n  Items: ";
     debugStatistics( debug, Items );
+
+    debug << "\n  Nodes: ";
+    for ( int i = 0; i < NodeTypeCount; i++ )
+    {
+        if ( i > 0 )
+            debug << ", ";
+
+        debug << qskNodeTypeNames[ i ] << ": " << qskNodeCounts[ i ].load();
+    }
+
+    if ( m_classData )
+    {
+        const auto classes = snapshot().classes;
+
+        QVector< QPair< int, QByteArray > > counts;
+        counts.reserve( classes.size() );
+
+        for ( auto it = classes.constBegin(); it != classes.constEnd(); ++it )
+            counts += qMakePair( it.value(), it.key() );
+
+        std::sort( counts.begin(), counts.end(),
+            []( const QPair< int, QByteArray >& c1, const QPair< int, QByteArray >& c2 )
+            { return c1.first > c2.first; } );
+
+        debug << "\n  Classes:";
+        for ( const auto& count : qskAsConst( counts ) )
+            debug << "\n    " << count.second.constData() << ": " << count.first;
+    }
 }
 
 #ifndef QT_NO_DEBUG_STREAM
@@ -270,5 +492,29 @@ QDebug operator<<( QDebug debug, const QskObjectCounter& counter )
     return debug;
 }
 
+QDebug operator<<( QDebug debug, const QskObjectCounter::Snapshot& snapshot )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "Snapshot(";
+    debug << "objects: " << snapshot.objects << ", items: " << snapshot.items;
+
+    for ( int i = 0; i < QskObjectCounter::NodeTypeCount; i++ )
+    {
+        debug << ", " << qskNodeTypeNames[ i ] << ": " << snapshot.nodes[ i ]
+            << " (" << snapshot.nodeBytes[ i ] << " bytes)";
+    }
+
+    for ( auto it = snapshot.classes.constBegin();
+        it != snapshot.classes.constEnd(); ++it )
+    {
+        debug << ", " << it.key().constData() << ": " << it.value();
+    }
+
+    debug << ')';
+    return debug;
+}
+
 #endif
 
@@ -8,6 +8,11 @@
 
 #include "QskGlobal.h"
 
+#include <QMap>
+#include <QByteArray>
+
+#include <memory>
+
 class QObject;
 class QDebug;
 class QskObjectCounterHook;
@@ -21,6 +26,34 @@ public:
         Items
     };
 
+    enum NodeType
+    {
+        BoxNode,
+        TextNode,
+        GlyphNode,
+        TextureNode
+    };
+
+    enum { NodeTypeCount = TextureNode + 1 };
+
+    class QSK_EXPORT Snapshot
+    {
+    public:
+        Snapshot();
+
+        // the changes since an earlier snapshot
+        Snapshot diff( const Snapshot& earlier ) const;
+
+        int objects;
+        int items;
+
+        // current objects per class, empty without class accounting
+        QMap< QByteArray, int > classes;
+
+        int nodes[ NodeTypeCount ];
+        qint64 nodeBytes[ NodeTypeCount ];
+    };
+
     QskObjectCounter( bool debugAtDestruction = false );
     ~QskObjectCounter();
 
@@ -34,15 +67,37 @@ public:
     int current( ObjectType = Objects ) const;
     int maximum( ObjectType = Objects ) const;
 
+    /*
+        With class accounting the objects are counted per class,
+        what needs to keep track of each object.
+     */
+    void setClassAccounting( bool );
+    bool hasClassAccounting() const;
+
+    Snapshot snapshot() const;
+
     void debugStatistics( QDebug, ObjectType = Objects ) const;
     void dump() const;
 
+    /*
+        The scene graph nodes are counted globally and
+        regardless of any counter being active.
+     */
+    static int nodeCount( NodeType );
+    static qint64 estimatedNodeBytes( NodeType );
+
+    // called from the nodes, usually in the scene graph thread
+    static void countNode( NodeType, int delta );
+    static void countNodeBytes( NodeType, qint64 delta );
+
 private:
     friend class QskObjectCounterHook;
 
     void addObject( QObject* );
     void removeObject( QObject* );
 
+    void resolveClasses() const;
+
     class Counter
     {
     public:
@@ -79,10 +134,14 @@ private:
 
     Counter m_counter[2];
     const bool m_debugAtDestruction;
+
+    class ClassData;
+    std::unique_ptr< ClassData > m_classData;
 };
 
 #ifndef QT_NO_DEBUG_STREAM
 QSK_EXPORT QDebug operator<<( QDebug, const QskObjectCounter& );
+QSK_EXPORT QDebug operator<<( QDebug, const QskObjectCounter::Snapshot& );
 #endif
 
 #endif
@@ -19,6 +19,9 @@ public:
     QskTextColors( const QColor& text = QColor(),
         const QColor& style = QColor(), const QColor& link = QColor() );
 
+    bool operator==( const QskTextColors& other ) const;
+    bool operator!=( const QskTextColors& other ) const;
+
     QskTextColors interpolated( const QskTextColors&, qreal value ) const;
 
     static QVariant interpolate( const QskTextColors&,
@@ -39,6 +42,18 @@ inline QskTextColors::QskTextColors(
 {
 }
 
+inline bool QskTextColors::operator==( const QskTextColors& other ) const
+{
+    return ( textColor == other.textColor )
+        && ( styleColor == other.styleColor )
+        && ( linkColor == other.linkColor );
+}
+
+inline bool QskTextColors::operator!=( const QskTextColors& other ) const
+{
+    return !( *this == other );
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 QSK_EXPORT QDebug operator<<( QDebug, const QskTextColors& );
@@ -4,6 +4,8 @@
  *****************************************************************************/
 
 #include "QskAnimator.h"
+#include "QskFrameProfiler.h"
+#include "QskWindow.h"
 
 #include <QObject>
 #include <QVector>
@@ -187,6 +189,16 @@ void QskAnimatorDriver::unregisterAnimator( QskAnimator* animator )
 
 void QskAnimatorDriver::advanceAnimators( QQuickWindow* window )
 {
+    QskFrameProfiler* profiler = nullptr;
+    if ( QskFrameProfiler::isActive() )
+    {
+        if ( auto w = qobject_cast< QskWindow* >( window ) )
+            profiler = w->profiler();
+    }
+
+    const QskFrameProfiler::Scope profilerScope(
+        profiler, QskFrameProfiler::AnimationPhase, "advanceAnimators" );
+
     bool hasAnimators = false;
     bool hasTerminations = false;
 
@@ -11,10 +11,17 @@
 #include "QskEvent.h"
 #include "QskDirtyItemFilter.h"
 #include "QskSkinHintTable.h"
+#include "QskColorFilter.h"
+#include "QskFrameProfiler.h"
+#include "QskWindow.h"
+#include "QskLayout.h"
 
+#include <QFont>
 #include <QLocale>
+#include <QStyleHints>
 #include <QVector>
 #include <QGlobalStatic>
+#include <QtMath>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -38,7 +45,26 @@ QSK_STATE( QskControl, Focused, QskAspect::LastSystemState )
 typedef quint16 controlFlags_t;
 
 void qskResolveLocale( QskControl* ); // not static as being used from outside !
+extern bool qskDeferPolish( QskControl* );
 static void qskUpdateControlFlags( QskControl::Flags, QskControl* );
+static void qskSendStyleChange( QskControl*, bool reuseNodes );
+
+static qint64 qskLayerMemory = 0; // bytes of all layer textures
+
+/*
+    Controls, that have been denied a layer as the limit had been reached.
+    They are retried, when memory gets released.
+ */
+typedef std::unordered_set< QskControl* > QskControlSet;
+Q_GLOBAL_STATIC( QskControlSet, qskPendingLayers )
+
+void qskUpdatePendingLayers(); // not static as being used from QskSetup.cpp
+
+// not static as being used from QskSetup.cpp
+qint64 qskLayerCacheUsage()
+{
+    return qskLayerMemory;
+}
 
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
@@ -46,6 +72,17 @@ static inline void qskSendEventTo( QObject* object, QEvent::Type type )
     QCoreApplication::sendEvent( object, &event );
 }
 
+static inline QskFrameProfiler* qskProfiler( const QQuickItem* item )
+{
+    if ( QskFrameProfiler::isActive() )
+    {
+        if ( auto window = qobject_cast< QskWindow* >( item->window() ) )
+            return window->profiler();
+    }
+
+    return nullptr;
+}
+
 QRectF qskItemRect( const QQuickItem* item )
 {
     auto d = QQuickItemPrivate::get( item );
@@ -280,9 +317,6 @@ namespace
              */
             QObject::connect( qskSetup, &QskSetup::controlFlagsChanged,
                 [this] { updateControlFlags(); } );
-
-            QObject::connect( qskSetup, &QskSetup::skinChanged,
-                [this] { updateSkin(); } );
         }
 
         inline void insert( QskControl* control )
@@ -303,18 +337,70 @@ namespace
                 qskUpdateControlFlags( flags, control );
         }
 
-        void updateSkin()
+        void updateSkin( const QskSkin* oldSkin, const QskSkin* newSkin )
         {
-            QEvent event( QEvent::StyleChange );
+            // graphics from the providers might be different for all controls
+            const bool hasGraphicProviders =
+                oldSkin->hasGraphicProvider() || newSkin->hasGraphicProvider();
+
+            QVector< QskAspect::Aspect > aspects;
+
+            if ( !hasGraphicProviders )
+            {
+                aspects = oldSkin->hintTable().changedAspects( newSkin->hintTable() );
+
+                if ( oldSkin->fonts() != newSkin->fonts() )
+                    aspects += QskAspect::Control | QskAspect::FontRole;
+
+                if ( oldSkin->graphicFilters() != newSkin->graphicFilters() )
+                    aspects += QskAspect::Control | QskAspect::GraphicRole;
+            }
 
             for ( auto control : m_controls )
             {
-                event.setAccepted( true );
-                QCoreApplication::sendEvent( control, &event );
+                bool reuseNodes = true;
+
+                if ( control->skinlet() == nullptr )
+                {
+                    /*
+                        The skinlet is exchanged silently, when being
+                        of the same class and the scene graph nodes of the
+                        previous skinlet can be reused. Otherwise they
+                        have to be recreated.
+                     */
+                    reuseNodes = oldSkin->skinletMetaObject( control )
+                        == newSkin->skinletMetaObject( control );
+                }
+
+                if ( !reuseNodes || hasGraphicProviders
+                    || control->dependsOnSkinHints( aspects ) )
+                {
+                    qskSendStyleChange( control, reuseNodes );
+                }
             }
         }
 
+        void updateSkinHints( const QVector< QskAspect::Aspect >& aspects )
+        {
+            if ( aspects.isEmpty() )
+                return;
+
+            updateControls( [&aspects] ( const QskControl* control )
+                { return control->dependsOnSkinHints( aspects ); } );
+        }
+
     private:
+        template< typename Filter >
+        void updateControls( Filter isAffected )
+        {
+            for ( auto control : m_controls )
+            {
+                // the skin is the same, so the skinlets are too
+                if ( isAffected( control ) )
+                    qskSendStyleChange( control, true );
+            }
+        }
+
         std::unordered_set< QskControl* > m_controls;
     };
 }
@@ -322,6 +408,20 @@ namespace
 Q_GLOBAL_STATIC( QskWindowStore, qskReleasedWindowCounter )
 Q_GLOBAL_STATIC( QskControlRegistry, qskRegistry )
 
+// not static as being used from QskSetup.cpp
+void qskUpdateSkin( const QskSkin* oldSkin, const QskSkin* newSkin )
+{
+    if ( qskRegistry.exists() )
+        qskRegistry->updateSkin( oldSkin, newSkin );
+}
+
+// not static as being used from QskSkinTransition.cpp
+void qskUpdateSkinHints( const QVector< QskAspect::Aspect >& aspects )
+{
+    if ( qskRegistry.exists() )
+        qskRegistry->updateSkinHints( aspects );
+}
+
 class QskControlPrivate final : public QQuickItemPrivate
 {
     Q_DECLARE_PUBLIC( QskControl )
@@ -335,12 +435,16 @@ public:
         autoLayoutChildren( false ),
         polishOnResize( false ),
         blockedPolish( false ),
+        deferredPolish( false ),
         blockedImplicitSize( true ),
         clearPreviousNodes( false ),
+        reuseNodes( false ),
         blockImplicitSizeNotification( false ),
         isInitiallyPainted( false ),
+        cachedAsLayer( false ),
         focusPolicy( Qt::NoFocus ),
-        isWheelEnabled( false )
+        isWheelEnabled( false ),
+        layerMemory( 0 )
     {
         if ( controlFlags & QskControl::DeferredLayout )
         {
@@ -439,6 +543,53 @@ public:
         return q->gestureFilter( child, event );
     }
 
+    void updateLayer()
+    {
+        /*
+            The layer is a QSGLayer, that renders the subtree only, when
+            one of its nodes has been marked dirty. We only have to decide
+            if the texture fits into the limit for all layers.
+         */
+
+        qint64 bytes = 0;
+
+        if ( cachedAsLayer && window )
+        {
+            const qreal ratio = window->effectiveDevicePixelRatio();
+            bytes = 4 * qint64( qCeil( width * ratio ) ) * qCeil( height * ratio );
+        }
+
+        const qint64 oldBytes = layerMemory;
+
+        qskLayerMemory -= layerMemory;
+        layerMemory = 0;
+
+        if ( bytes > 0 && qskLayerMemory + bytes <= qskSetup->layerCacheLimit() )
+        {
+            layerMemory = bytes;
+            qskLayerMemory += bytes;
+        }
+
+        Q_Q( QskControl );
+
+        if ( bytes > 0 && layerMemory == 0 )
+            qskPendingLayers->insert( q );
+        else
+            qskPendingLayers->erase( q );
+
+        const bool on = layerMemory > 0;
+
+        if ( on || ( extra.isAllocated() && extra->layer ) )
+        {
+            auto layer = this->layer();
+            if ( layer->enabled() != on )
+                layer->setEnabled( on );
+        }
+
+        if ( layerMemory < oldBytes )
+            qskUpdatePendingLayers();
+    }
+
     void updateControlFlags( QskControl::Flags flags )
     {
         Q_Q( QskControl );
@@ -473,15 +624,22 @@ public:
     bool polishOnResize : 1;
 
     bool blockedPolish : 1;
+    bool deferredPolish : 1; // waiting in the deferred items of QskWindow
     bool blockedImplicitSize : 1;
     bool clearPreviousNodes : 1;
+    bool reuseNodes : 1; // while handling a QEvent::StyleChange
 
     bool blockImplicitSizeNotification : 1;
 
     bool isInitiallyPainted : 1;
+    bool cachedAsLayer : 1;
 
     uint focusPolicy : 4;
     bool isWheelEnabled : 1;
+
+    qint64 layerMemory; // being accounted in qskLayerMemory
+
+    QRectF clipRect;
 };
 
 static void qskUpdateControlFlags( QskControl::Flags flags, QskControl* control )
@@ -490,6 +648,55 @@ static void qskUpdateControlFlags( QskControl::Flags flags, QskControl* control
     d->updateControlFlags( flags );
 }
 
+static void qskSendStyleChange( QskControl* control, bool reuseNodes )
+{
+    auto d = static_cast< QskControlPrivate* >( QQuickItemPrivate::get( control ) );
+
+    d->reuseNodes = reuseNodes;
+
+    QEvent event( QEvent::StyleChange );
+    QCoreApplication::sendEvent( control, &event );
+
+    d->reuseNodes = false;
+}
+
+void qskUpdatePendingLayers()
+{
+    static bool isUpdating = false;
+
+    if ( isUpdating || qskPendingLayers.isDestroyed() || qskPendingLayers->empty() )
+        return;
+
+    isUpdating = true;
+
+    // updateLayer modifies the pending layers
+    const auto controls = *qskPendingLayers;
+
+    for ( auto control : controls )
+    {
+        if ( qskLayerMemory >= qskSetup->layerCacheLimit() )
+            break;
+
+        auto d = static_cast< QskControlPrivate* >( QQuickItemPrivate::get( control ) );
+        d->updateLayer();
+    }
+
+    isUpdating = false;
+}
+
+// not static as being used from QskWindow.cpp
+bool qskSetPolishDeferred( QskControl* control, bool on )
+{
+    // returns the previous state
+
+    auto d = static_cast< QskControlPrivate* >( QQuickItemPrivate::get( control ) );
+
+    const bool wasDeferred = d->deferredPolish;
+    d->deferredPolish = on;
+
+    return wasDeferred;
+}
+
 QskControl::QskControl( QQuickItem* parent ):
     Inherited( *( new QskControlPrivate() ), parent )
 {
@@ -514,7 +721,7 @@ QskControl::QskControl( QQuickItem* parent ):
 #endif
 
     Q_D( QskControl );
-    if ( d->controlFlags & QskControl::DeferredUpdate )
+    if ( d->controlFlags & ( QskControl::DeferredUpdate | QskControl::CullOutsideWindow ) )
         qskFilterWindow( window() );
 
     qskRegistry->insert( this );
@@ -532,6 +739,17 @@ QskControl::~QskControl()
      */
     Q_D( QskControl );
     d->componentComplete = false;
+
+    if ( !qskPendingLayers.isDestroyed() )
+        qskPendingLayers->erase( this );
+
+    if ( d->layerMemory > 0 )
+    {
+        qskLayerMemory -= d->layerMemory;
+        d->layerMemory = 0;
+
+        qskUpdatePendingLayers();
+    }
 }
 
 const char* QskControl::className() const
@@ -697,6 +915,23 @@ bool QskControl::isWheelEnabled() const
     return d_func()->isWheelEnabled;
 }
 
+void QskControl::setCachedAsLayer( bool on )
+{
+    Q_D( QskControl );
+    if ( on != d->cachedAsLayer )
+    {
+        d->cachedAsLayer = on;
+        d->updateLayer();
+
+        Q_EMIT cachedAsLayerChanged();
+    }
+}
+
+bool QskControl::isCachedAsLayer() const
+{
+    return d_func()->cachedAsLayer;
+}
+
 void QskControl::setFocusPolicy( Qt::FocusPolicy policy )
 {
     Q_D( QskControl );
@@ -847,6 +1082,27 @@ void QskControl::updateControlFlag( uint flag, bool on )
 
             break;
         }
+        case QskControl::CullOutsideWindow:
+        {
+            /*
+                When disabling the flag QskDirtyItemFilter
+                restores the blocked updates with the next frame,
+                that is requested by adding us to the dirty list.
+             */
+            if ( on )
+                qskFilterWindow( window() );
+            else
+                update();
+
+            break;
+        }
+        case QskControl::ConcurrentLayout:
+        {
+            if ( on )
+                polish();
+
+            break;
+        }
         case QskControl::DebugForceBackground:
         {
             // no need to mark it dirty
@@ -1140,12 +1396,89 @@ void QskControl::resetImplicitSize()
     }
 }
 
+static bool qskFilterInputEvent( QskControl* control, QEvent* event )
+{
+    /*
+        Qt::FocusPolicy has always been there with widgets, got lost with
+        Qt/Quick and has been reintroduced with Qt/Quick Controls 2 ( QC2 ).
+        Unfortunately this was done once more by adding code on top instead
+        of fixing the foundation.
+
+        But we also don't want to have how it is done in QC2 by adding
+        the focus management in the event handlers of the base class.
+        This implementation reverts the expected default behaviour of when
+        events are accepted/ignored + is an error prone nightmare, when it
+        comes to overloading event handlers missing to call the base class.
+
+        That's why we do the focus management before the events are
+        dispatched to the event handlers. Doing this from an event filter
+        for the application would be more robust, but then we would
+        have to inspect every event of every object.
+     */
+
+    switch( event->type() )
+    {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        {
+            if ( ( control->focusPolicy() & Qt::ClickFocus ) == Qt::ClickFocus )
+            {
+                const bool focusOnRelease =
+                    QGuiApplication::styleHints()->setFocusOnTouchRelease();
+
+                if ( focusOnRelease )
+                {
+                    if ( event->type() == QEvent::MouseButtonRelease )
+                        control->forceActiveFocus( Qt::MouseFocusReason );
+                }
+                else
+                {
+                    if ( event->type() == QEvent::MouseButtonPress )
+                        control->forceActiveFocus( Qt::MouseFocusReason );
+                }
+            }
+            break;
+        }
+        case QEvent::Wheel:
+        {
+            if ( !control->isWheelEnabled() )
+            {
+                /*
+                    We block further processing of the event. This is in line
+                    with not receiving any mouse event that have not been
+                    explicitly enabled with setAcceptedMouseButtons().
+                 */
+                event->ignore();
+                return true;
+            }
+
+            if ( ( control->focusPolicy() & Qt::WheelFocus ) == Qt::WheelFocus )
+                control->forceActiveFocus( Qt::MouseFocusReason );
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    return false;
+}
+
 bool QskControl::event( QEvent* event )
 {
     const int eventType = event->type();
 
     switch( eventType )
     {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::Wheel:
+        {
+            if ( qskFilterInputEvent( this, event ) )
+                return true;
+
+            break;
+        }
 #if 0
         case QEvent::PolishRequest:
         {
@@ -1193,11 +1526,12 @@ bool QskControl::event( QEvent* event )
                 We might have a totally different skinlet,
                 that can't deal with nodes created from other skinlets
              */
-            d_func()->clearPreviousNodes = true;
+            if ( !d_func()->reuseNodes )
+                d_func()->clearPreviousNodes = true;
 
             resetImplicitSize();
             polish();
-            update();
+            updateNodeRoles( ~quint64( 0 ) );
 
             changeEvent( event );
             return true;
@@ -1281,11 +1615,12 @@ void QskControl::changeEvent( QEvent* event )
             different skinlets, that can't deal with nodes
             created from other skinlets
          */
-        d_func()->clearPreviousNodes = true;
+        if ( !d_func()->reuseNodes )
+            d_func()->clearPreviousNodes = true;
 
         resetImplicitSize();
         polish();
-        update();
+        updateNodeRoles( ~quint64( 0 ) );
     }
 }
 
@@ -1403,10 +1738,13 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
         {
             if ( value.window )
             {
-                if ( d->controlFlags & QskControl::DeferredUpdate )
+                if ( d->controlFlags & ( QskControl::DeferredUpdate | QskControl::CullOutsideWindow ) )
                     qskFilterWindow( value.window );
             }
 
+            if ( d->cachedAsLayer )
+                d->updateLayer();
+
             QskWindowChangeEvent event(
                 qskReleasedWindowCounter->window(), value.window );
             QCoreApplication::sendEvent( this, &event );
@@ -1418,6 +1756,13 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
             setSkinStateFlag( Focused, hasActiveFocus() );
             break;
         }
+        case QQuickItem::ItemDevicePixelRatioHasChanged:
+        {
+            if ( d->cachedAsLayer )
+                d->updateLayer();
+
+            break;
+        }
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
         case QQuickItem::ItemEnabledHasChanged:
         {
@@ -1439,9 +1784,15 @@ void QskControl::geometryChanged(
 
     if ( newGeometry.size() != oldGeometry.size() )
     {
-        Q_D( const QskControl );
+        Q_D( QskControl );
         if ( d->polishOnResize || d->autoLayoutChildren )
             polish();
+
+        if ( d->cachedAsLayer )
+            d->updateLayer();
+
+        // all nodes depend on the size
+        updateNodeRoles( ~quint64( 0 ) );
     }
 
     QskGeometryChangeEvent event( newGeometry, oldGeometry );
@@ -1451,8 +1802,18 @@ void QskControl::geometryChanged(
 void QskControl::layoutConstraintChanged()
 {
     QQuickItem* item = parentItem();
-    if ( item )
+    if ( item == nullptr )
+        return;
+
+    if ( auto layout = qobject_cast< QskLayout* >( item ) )
+    {
+        // a layout only needs to invalidate the hints of this control
+        layout->invalidateItem( this );
+    }
+    else
+    {
         qskSendEventTo( item, QEvent::LayoutRequest );
+    }
 }
 
 void QskControl::updatePolish()
@@ -1470,6 +1831,12 @@ void QskControl::updatePolish()
 
     d->blockedPolish = false;
 
+    if ( qskDeferPolish( this ) )
+        return;
+
+    const QskFrameProfiler::Scope profilerScope(
+        qskProfiler( this ), QskFrameProfiler::PolishPhase, metaObject() );
+
     if ( d->autoLayoutChildren )
     {
         const QRectF rect = layoutRect();
@@ -1493,6 +1860,9 @@ QSGNode* QskControl::updatePaintNode( QSGNode* node, UpdatePaintNodeData* data )
 
     Q_ASSERT( isVisible() || !( d->controlFlags & QskControl::DeferredUpdate ) );
 
+    const QskFrameProfiler::Scope profilerScope(
+        qskProfiler( this ), QskFrameProfiler::SyncPhase, metaObject() );
+
     if ( !d->isInitiallyPainted )
         d->isInitiallyPainted = true;
 
@@ -1573,6 +1943,43 @@ QRectF QskControl::focusIndicatorRect() const
     return contentsRect();
 }
 
+void QskControl::setClipRect( const QRectF& rect )
+{
+    Q_D( QskControl );
+
+    const QRectF clipRect = rect.isValid() ? rect : QRectF();
+    if ( clipRect != d->clipRect )
+    {
+        d->clipRect = clipRect;
+
+        /*
+            QQuickWindow updates the rectangle of the clip node,
+            when the size has changed.
+         */
+        if ( d->clipNode() )
+            d->dirty( QQuickItemPrivate::Size );
+    }
+}
+
+void QskControl::resetClipRect()
+{
+    setClipRect( QRectF() );
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK( 5, 7, 0 )
+
+QRectF QskControl::clipRect() const
+{
+    Q_D( const QskControl );
+
+    if ( d->clipRect.isValid() )
+        return d->clipRect;
+
+    return Inherited::clipRect();
+}
+
+#endif
+
 void QskControl::updateLayout()
 {
 }
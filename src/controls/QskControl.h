@@ -53,6 +53,9 @@ class QSK_EXPORT QskControl : public QQuickItem, public QskResizable, public Qsk
     Q_PROPERTY( bool tabFence READ isTabFence
         WRITE setTabFence NOTIFY controlFlagsChanged FINAL )
 
+    Q_PROPERTY( bool cachedAsLayer READ isCachedAsLayer
+        WRITE setCachedAsLayer NOTIFY cachedAsLayerChanged FINAL )
+
     Q_PROPERTY( QMarginsF margins READ margins
         WRITE setMargins RESET resetMargins NOTIFY marginsChanged )
 
@@ -79,6 +82,8 @@ public:
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        CullOutsideWindow       =  1 << 5,
+        ConcurrentLayout        =  1 << 6,
 
         DebugForceBackground    =  1 << 7,
 
@@ -113,6 +118,21 @@ public:
     virtual QRectF gestureRect() const;
     virtual QRectF focusIndicatorRect() const;
 
+    /*
+        When clip() is enabled the children are clipped against clipRect(),
+        what is done by a rectangular clip node, that is supported
+        by the scissor test. So an animated clip rectangle can be
+        implemented without introducing an extra item.
+        An invalid rectangle restores the default, the bounding rectangle.
+        As QQuickItem::clipRect() is not virtual before Qt 5.7 setting
+        a clip rectangle has no effect for older versions.
+     */
+    void setClipRect( const QRectF& );
+    void resetClipRect();
+#if QT_VERSION >= QT_VERSION_CHECK( 5, 7, 0 )
+    virtual QRectF clipRect() const override;
+#endif
+
     void setAutoFillBackground( bool );
     bool autoFillBackground() const;
 
@@ -134,6 +154,16 @@ public:
     void setTabFence( bool );
     bool isTabFence() const;
 
+    /*
+        The subtree of the control is rendered into a texture, that is
+        reused until something below the control changes. The memory
+        for all layers is limited by QskSetup::layerCacheLimit(). When
+        exceeding it, the control is rendered without a layer, until
+        enough memory has been released by other layers.
+     */
+    void setCachedAsLayer( bool );
+    bool isCachedAsLayer() const;
+
     void setControlFlags( Flags );
     void resetControlFlags();
     Flags controlFlags() const;
@@ -173,6 +203,7 @@ Q_SIGNALS:
     void controlFlagsChanged();
     void focusPolicyChanged();
     void wheelEnabledChanged();
+    void cachedAsLayerChanged();
 
 public Q_SLOTS:
     void setGeometry( const QRectF& );
@@ -22,22 +22,76 @@ static inline bool qskIsUpdateBlocked( const QQuickItem* item )
             return control->testControlFlag( QskControl::DeferredUpdate );
     }
 
-#if 0
+    return false;
+}
+
+static inline bool qskIsCullable( const QQuickItem* item )
+{
+    if ( const auto control = qobject_cast< const QskControl* >( item ) )
+        return control->testControlFlag( QskControl::CullOutsideWindow );
+
+    return false;
+}
+
+namespace
+{
     /*
-        Blocking items, that are outside the window would be easy,
-        but we have not yet found a performant way to send update notifications
-        when an item enters/leaves the window. TODO ...
+        Mapping the bounding rectangles of items to scene coordinates,
+        where the transformation of the parent item is calculated only once
+        for all siblings. For the typical situation, where many items
+        are children of the same viewport, this reduces the costs
+        to a single walk up the tree for each parent.
      */
-    else if ( const auto control = qobject_cast< const QskControl* >( item ) )
+    class SceneRectMapper
     {
-        const QRectF itemRect( item->mapToScene( QPointF() ), item->size() );
-        const QRectF sceneRect( 0, 0, item->window()->width(), item->window()->height() );
+    public:
+        QRectF sceneRect( const QQuickItem* item )
+        {
+            const auto d = QQuickItemPrivate::get( item );
 
-        return !itemRect.intersects( sceneRect );
-    }
+            QTransform transform;
+            d->itemToParentTransform( transform );
+
+            if ( const auto parentItem = item->parentItem() )
+            {
+                auto it = m_transforms.constFind( parentItem );
+                if ( it == m_transforms.constEnd() )
+                {
+                    it = m_transforms.insert( parentItem,
+                        QQuickItemPrivate::get( parentItem )->itemToWindowTransform() );
+                }
+
+                transform *= it.value();
+            }
+
+            return transform.mapRect( QRectF( 0, 0, d->width, d->height ) );
+        }
+
+    private:
+        QHash< const QQuickItem*, QTransform > m_transforms;
+    };
+}
+
+static inline bool qskIsMoved( const QQuickItem* item )
+{
+    // changes, that affect the bounding rectangle in scene coordinates
+    const quint32 mask = QQuickItemPrivate::TransformOrigin
+        | QQuickItemPrivate::Transform | QQuickItemPrivate::BasicTransform
+        | QQuickItemPrivate::Position | QQuickItemPrivate::Size
+        | QQuickItemPrivate::ParentChanged | QQuickItemPrivate::Window;
+
+    return ( QQuickItemPrivate::get( item )->dirtyAttributes & mask ) != 0;
 }
-#endif
-    
+
+static inline bool qskHasMovedAncestor(
+    const QQuickItem* item, const QSet< const QQuickItem* >& movedItems )
+{
+    for ( ; item != nullptr; item = item->parentItem() )
+    {
+        if ( movedItems.contains( item ) )
+            return true;
+    }
+
     return false;
 }
 
@@ -82,12 +136,17 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
         Qt::DirectConnection );
 
     connect( window, &QObject::destroyed,
-        this, [ this, window ] { m_windows.remove( window ); } );
+        this, [ this, window ]
+        {
+            m_windows.remove( window );
+            m_culledItems.remove( window );
+        } );
 }
 
 void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
 {
     filterDirtyList( window, qskIsUpdateBlocked );
+    cullDirtyList( window );
 
     if ( QQuickWindowPrivate::get( window )->renderer == nullptr )
     {
@@ -103,6 +162,120 @@ void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
     }
 }
 
+void QskDirtyItemFilter::cullDirtyList( QQuickWindow* window )
+{
+    /*
+        Items outside of the window don't need to update their
+        scene graph nodes. We remove them from the dirty list
+        and reinsert them, when they intersect the window again.
+
+        As we don't have any notification about items entering/leaving
+        the window, we look for moved items in the dirty list. Moving
+        an item in or out of the window always results in a new frame,
+        as some item has been modified for it. The bounding rectangles
+        of the culled items are cached and calculated again only,
+        when the item or one of its parents has been moved.
+     */
+
+    if ( QQuickWindowPrivate::get( window )->renderer == nullptr )
+    {
+        // the dirty list gets updated again after beforeSynchronizing
+        return;
+    }
+
+    const QRectF windowRect( 0, 0, window->width(), window->height() );
+    auto& culledItems = m_culledItems[ window ];
+
+    auto d = QQuickWindowPrivate::get( window );
+
+    QSet< const QQuickItem* > movedItems;
+
+    for ( QQuickItem* item = d->dirtyItemList; item != nullptr;
+        item = QQuickItemPrivate::get( item )->nextDirtyItem )
+    {
+        if ( qskIsMoved( item ) )
+            movedItems += item;
+
+        /*
+            A culled item, that has been added to the dirty list again,
+            is treated like any other dirty item below. F.e QskControl
+            does this, when disabling QskControl::CullOutsideWindow.
+         */
+        culledItems.items.remove( item );
+    }
+
+    const bool isResized = ( windowRect != culledItems.windowRect );
+    culledItems.windowRect = windowRect;
+
+    SceneRectMapper mapper;
+
+    if ( isResized || !movedItems.isEmpty() )
+    {
+        for ( auto it = culledItems.items.begin(); it != culledItems.items.end(); )
+        {
+            const auto item = it.value().item.data();
+
+            if ( item == nullptr || item->window() != window )
+            {
+                it = culledItems.items.erase( it );
+                continue;
+            }
+
+            auto& sceneRect = it.value().sceneRect;
+
+            if ( qskHasMovedAncestor( item, movedItems ) )
+                sceneRect = mapper.sceneRect( item );
+
+            if ( !qskIsCullable( item ) || sceneRect.intersects( windowRect ) )
+            {
+                /*
+                    addToDirtyList also schedules an update of the window,
+                    what is necessary as we might be inside of the
+                    last synchronization of a series of frames.
+                 */
+                auto itemData = QQuickItemPrivate::get( item );
+                if ( itemData->dirtyAttributes && itemData->prevDirtyItem == nullptr )
+                    itemData->addToDirtyList();
+
+                it = culledItems.items.erase( it );
+                continue;
+            }
+
+            ++it;
+        }
+    }
+
+    for ( QQuickItem* item = d->dirtyItemList; item != nullptr; )
+    {
+        auto itemData = QQuickItemPrivate::get( item );
+        auto nextItem = itemData->nextDirtyItem;
+
+        /*
+            Changes of the transformation or the structure of the tree
+            are never blocked, as they might affect child items,
+            that are not culled.
+         */
+        const bool isContentChange = ( itemData->dirtyAttributes &
+            ~( QQuickItemPrivate::Content | QQuickItemPrivate::Size ) ) == 0;
+
+        if ( isContentChange && qskIsCullable( item ) && item->isVisible() )
+        {
+            const auto sceneRect = mapper.sceneRect( item );
+
+            if ( !sceneRect.intersects( windowRect ) )
+            {
+                itemData->removeFromDirtyList();
+                culledItems.items.insert( item, { item, sceneRect } );
+            }
+        }
+
+        item = nextItem;
+    }
+
+    if ( culledItems.items.isEmpty() )
+        m_culledItems.remove( window );
+}
+
 void QskDirtyItemFilter::resetBlockedDirty()
 {
     auto window = qobject_cast< QQuickWindow* >( sender() );
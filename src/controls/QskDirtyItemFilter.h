@@ -10,6 +10,9 @@
 
 #include <QObject>
 #include <QSet>
+#include <QHash>
+#include <QPointer>
+#include <QRectF>
 
 class QQuickWindow;
 class QQuickItem;
@@ -31,7 +34,26 @@ private:
     void beforeSynchronizing( QQuickWindow* );
     void resetBlockedDirty();
 
+    void cullDirtyList( QQuickWindow* );
+
     QSet< QObject* > m_windows;
+
+    class CulledItem
+    {
+    public:
+        QPointer< QQuickItem > item;
+        QRectF sceneRect; // valid until the item or one of its parents is moved
+    };
+
+    class CulledItems
+    {
+    public:
+        QRectF windowRect;
+        QHash< QQuickItem*, CulledItem > items;
+    };
+
+    // items outside of the window, that have been removed from the dirty list
+    QHash< QObject*, CulledItems > m_culledItems;
 };
 
 #endif
@@ -0,0 +1,506 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskFrameProfiler.h"
+
+#include <QQuickWindow>
+#include <QMetaObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QHash>
+#include <QAtomicInt>
+
+#include <algorithm>
+
+static QAtomicInt qskActiveProfilers;
+
+static QAtomicInt qskCreatedNodes;
+static QAtomicInt qskDeletedNodes;
+
+static const char* qskPhaseNames[] = { "polish", "animation", "sync", "render" };
+
+namespace
+{
+    template< typename T >
+    class Ring
+    {
+    public:
+        Ring( int capacity ):
+            m_capacity( capacity ),
+            m_pos( 0 )
+        {
+        }
+
+        void setCapacity( int capacity )
+        {
+            QVector< T > values = this->values();
+            if ( values.size() > capacity )
+                values.remove( 0, values.size() - capacity );
+
+            m_values = values;
+            m_capacity = capacity;
+            m_pos = 0;
+        }
+
+        inline int capacity() const
+        {
+            return m_capacity;
+        }
+
+        void append( const T& value )
+        {
+            if ( m_values.size() < m_capacity )
+            {
+                m_values += value;
+            }
+            else
+            {
+                m_values[ m_pos ] = value;
+                m_pos = ( m_pos + 1 ) % m_capacity;
+            }
+        }
+
+        QVector< T > values() const
+        {
+            if ( m_pos == 0 )
+                return m_values;
+
+            // the oldest value is at m_pos
+            return m_values.mid( m_pos ) + m_values.mid( 0, m_pos );
+        }
+
+        void clear()
+        {
+            m_values.clear();
+            m_pos = 0;
+        }
+
+    private:
+        QVector< T > m_values;
+        int m_capacity;
+        int m_pos;
+    };
+
+    class Event
+    {
+    public:
+        const char* name;
+        QskFrameProfiler::Phase phase;
+
+        qint64 start;
+        qint64 duration;
+    };
+}
+
+static inline QskFrameProfiler::Frame qskEmptyFrame()
+{
+    QskFrameProfiler::Frame frame;
+
+    for ( int i = 0; i < QskFrameProfiler::PhaseCount; i++ )
+        frame.times[ i ] = 0;
+
+    frame.createdNodes = frame.deletedNodes = 0;
+
+    return frame;
+}
+
+static inline bool qskHasClassTimings( QskFrameProfiler::Phase phase )
+{
+    return ( phase == QskFrameProfiler::PolishPhase )
+        || ( phase == QskFrameProfiler::SyncPhase );
+}
+
+static inline int qskThreadId( QskFrameProfiler::Phase phase )
+{
+    // polishing/animating happens in the GUI thread, the rest in the scene graph thread
+    return ( phase == QskFrameProfiler::PolishPhase
+        || phase == QskFrameProfiler::AnimationPhase ) ? 1 : 2;
+}
+
+class QskFrameProfiler::PrivateData
+{
+public:
+    PrivateData( QQuickWindow* window ):
+        window( window ),
+        frames( 240 ),
+        events( 100000 ),
+        polishStart( -1 ),
+        syncStart( -1 ),
+        renderStart( -1 )
+    {
+        guiFrame = currentFrame = qskEmptyFrame();
+        clock.start();
+    }
+
+    QQuickWindow* window;
+    QVector< QMetaObject::Connection > connections;
+
+    QAtomicInt enabled;
+    QElapsedTimer clock;
+
+    /*
+        Polishing/animating might run in the GUI thread, while the scene
+        graph thread is rendering the previous frame.
+     */
+    mutable QMutex mutex;
+
+    Ring< Frame > frames;
+    Ring< Event > events;
+
+    QHash< const char*, ClassTiming > classTimings[ PhaseCount ];
+
+    Frame guiFrame;     // polishing/animating, not yet synchronized
+    Frame currentFrame; // synchronized, but not yet rendered
+
+    qint64 polishStart;
+    qint64 syncStart;
+    qint64 renderStart;
+};
+
+QskFrameProfiler::Scope::Scope( QskFrameProfiler* profiler,
+        Phase phase, const QMetaObject* metaObject ):
+    Scope( profiler, phase, metaObject->className() )
+{
+}
+
+QskFrameProfiler::Scope::Scope(
+        QskFrameProfiler* profiler, Phase phase, const char* name ):
+    m_profiler( nullptr ),
+    m_name( name ),
+    m_phase( phase ),
+    m_start( 0 )
+{
+    if ( profiler && profiler->isEnabled() )
+    {
+        m_profiler = profiler;
+        m_start = profiler->timestamp();
+
+        auto d = profiler->m_data.get();
+
+        if ( phase == PolishPhase )
+        {
+            if ( d->polishStart < 0 )
+                d->polishStart = m_start;
+        }
+        else if ( phase == AnimationPhase )
+        {
+            // animators are advanced after the polish pass
+            profiler->finishPolishing();
+        }
+    }
+}
+
+QskFrameProfiler::Scope::~Scope()
+{
+    if ( m_profiler )
+    {
+        const auto end = m_profiler->timestamp();
+        m_profiler->addEvent( m_phase, m_name, m_start, end );
+
+        if ( m_phase == AnimationPhase )
+        {
+            QMutexLocker locker( &m_profiler->m_data->mutex );
+            m_profiler->m_data->guiFrame.times[ AnimationPhase ] += end - m_start;
+        }
+    }
+}
+
+QskFrameProfiler::QskFrameProfiler( QQuickWindow* window ):
+    m_data( new PrivateData( window ) )
+{
+}
+
+QskFrameProfiler::~QskFrameProfiler()
+{
+    setEnabled( false );
+}
+
+void QskFrameProfiler::setEnabled( bool on )
+{
+    if ( on == isEnabled() )
+        return;
+
+    auto window = m_data->window;
+
+    if ( on )
+    {
+        m_data->enabled.storeRelease( 1 );
+        qskActiveProfilers.ref();
+
+        /*
+            The scene graph thread is running the synchronization/rendering
+            slots, so we need direct connections.
+         */
+        m_data->connections += QObject::connect( window,
+            &QQuickWindow::afterAnimating, window,
+            [ this ] { finishPolishing(); }, Qt::DirectConnection );
+
+        m_data->connections += QObject::connect( window,
+            &QQuickWindow::beforeSynchronizing, window,
+            [ this ] { startSync(); }, Qt::DirectConnection );
+
+        m_data->connections += QObject::connect( window,
+            &QQuickWindow::afterSynchronizing, window,
+            [ this ] { finishSync(); }, Qt::DirectConnection );
+
+        m_data->connections += QObject::connect( window,
+            &QQuickWindow::beforeRendering, window,
+            [ this ] { startRendering(); }, Qt::DirectConnection );
+
+        m_data->connections += QObject::connect( window,
+            &QQuickWindow::afterRendering, window,
+            [ this ] { finishRendering(); }, Qt::DirectConnection );
+    }
+    else
+    {
+        for ( const auto& connection : qskAsConst( m_data->connections ) )
+            QObject::disconnect( connection );
+
+        m_data->connections.clear();
+
+        m_data->enabled.storeRelease( 0 );
+        qskActiveProfilers.deref();
+    }
+}
+
+bool QskFrameProfiler::isEnabled() const
+{
+    return m_data->enabled.loadAcquire() != 0;
+}
+
+void QskFrameProfiler::reset()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->frames.clear();
+    m_data->events.clear();
+
+    for ( auto& timings : m_data->classTimings )
+        timings.clear();
+
+    m_data->guiFrame = m_data->currentFrame = qskEmptyFrame();
+    m_data->polishStart = m_data->syncStart = m_data->renderStart = -1;
+}
+
+void QskFrameProfiler::setFrameCapacity( int capacity )
+{
+    capacity = qMax( capacity, 1 );
+
+    QMutexLocker locker( &m_data->mutex );
+    m_data->frames.setCapacity( capacity );
+}
+
+int QskFrameProfiler::frameCapacity() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->frames.capacity();
+}
+
+QVector< QskFrameProfiler::Frame > QskFrameProfiler::frames() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->frames.values();
+}
+
+QVector< int > QskFrameProfiler::histogram(
+    Phase phase, int bucketSize, int bucketCount ) const
+{
+    bucketSize = qMax( bucketSize, 1 );
+    bucketCount = qMax( bucketCount, 1 );
+
+    QVector< int > buckets( bucketCount, 0 );
+
+    const auto frames = this->frames();
+    for ( const auto& frame : frames )
+    {
+        const qint64 idx = frame.times[ phase ] / bucketSize;
+        buckets[ int( qMin( idx, qint64( bucketCount - 1 ) ) ) ]++;
+    }
+
+    return buckets;
+}
+
+QVector< QskFrameProfiler::ClassTiming > QskFrameProfiler::classTimings( Phase phase ) const
+{
+    QVector< ClassTiming > timings;
+
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        const auto& hash = m_data->classTimings[ phase ];
+
+        timings.reserve( hash.size() );
+        for ( auto it = hash.constBegin(); it != hash.constEnd(); ++it )
+            timings += it.value();
+    }
+
+    std::sort( timings.begin(), timings.end(),
+        []( const ClassTiming& t1, const ClassTiming& t2 ) { return t1.time > t2.time; } );
+
+    return timings;
+}
+
+QByteArray QskFrameProfiler::chromeTrace() const
+{
+    QVector< Event > events;
+    {
+        QMutexLocker locker( &m_data->mutex );
+        events = m_data->events.values();
+    }
+
+    QByteArray json;
+    json.reserve( 100 * events.size() + 32 );
+
+    json += "{\"traceEvents\":[";
+
+    for ( int i = 0; i < events.size(); i++ )
+    {
+        const auto& event = events[ i ];
+
+        if ( i > 0 )
+            json += ',';
+
+        /*
+            The names are class names or phase names, so we
+            don't need to care about escaping
+         */
+        json += "\n{\"name\":\"";
+        json += event.name;
+        json += "\",\"cat\":\"";
+        json += qskPhaseNames[ event.phase ];
+        json += "\",\"ph\":\"X\",\"ts\":";
+        json += QByteArray::number( event.start );
+        json += ",\"dur\":";
+        json += QByteArray::number( event.duration );
+        json += ",\"pid\":1,\"tid\":";
+        json += QByteArray::number( qskThreadId( event.phase ) );
+        json += '}';
+    }
+
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return json;
+}
+
+bool QskFrameProfiler::isActive()
+{
+    return qskActiveProfilers.load() > 0;
+}
+
+void QskFrameProfiler::countNodes( int created, int deleted )
+{
+    if ( created )
+        qskCreatedNodes.fetchAndAddRelaxed( created );
+
+    if ( deleted )
+        qskDeletedNodes.fetchAndAddRelaxed( deleted );
+}
+
+void QskFrameProfiler::addEvent(
+    Phase phase, const char* name, qint64 start, qint64 end )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->events.append( { name, phase, start, end - start } );
+
+    if ( qskHasClassTimings( phase ) && name != qskPhaseNames[ phase ] )
+    {
+        auto& timings = m_data->classTimings[ phase ];
+
+        auto it = timings.find( name );
+        if ( it == timings.end() )
+            it = timings.insert( name, { name, 0, 0 } );
+
+        it->count++;
+        it->time += end - start;
+    }
+}
+
+qint64 QskFrameProfiler::timestamp() const
+{
+    return m_data->clock.nsecsElapsed() / 1000;
+}
+
+void QskFrameProfiler::finishPolishing()
+{
+    // GUI thread
+    auto d = m_data.get();
+
+    if ( d->polishStart < 0 )
+        return;
+
+    const auto end = timestamp();
+    addEvent( PolishPhase, qskPhaseNames[ PolishPhase ], d->polishStart, end );
+
+    {
+        QMutexLocker locker( &d->mutex );
+        d->guiFrame.times[ PolishPhase ] += end - d->polishStart;
+    }
+
+    d->polishStart = -1;
+}
+
+void QskFrameProfiler::startSync()
+{
+    // scene graph thread, while the GUI thread is blocked
+    auto d = m_data.get();
+
+    d->syncStart = timestamp();
+
+    QMutexLocker locker( &d->mutex );
+
+    for ( auto phase : { PolishPhase, AnimationPhase } )
+    {
+        d->currentFrame.times[ phase ] = d->guiFrame.times[ phase ];
+        d->guiFrame.times[ phase ] = 0;
+    }
+
+    // nodes, that have been created/deleted outside of the sync phase
+    qskCreatedNodes.fetchAndStoreRelaxed( 0 );
+    qskDeletedNodes.fetchAndStoreRelaxed( 0 );
+}
+
+void QskFrameProfiler::finishSync()
+{
+    auto d = m_data.get();
+
+    if ( d->syncStart < 0 )
+        return;
+
+    const auto end = timestamp();
+    addEvent( SyncPhase, qskPhaseNames[ SyncPhase ], d->syncStart, end );
+
+    QMutexLocker locker( &d->mutex );
+
+    d->currentFrame.times[ SyncPhase ] = end - d->syncStart;
+    d->currentFrame.createdNodes = qskCreatedNodes.fetchAndStoreRelaxed( 0 );
+    d->currentFrame.deletedNodes = qskDeletedNodes.fetchAndStoreRelaxed( 0 );
+
+    d->syncStart = -1;
+}
+
+void QskFrameProfiler::startRendering()
+{
+    m_data->renderStart = timestamp();
+}
+
+void QskFrameProfiler::finishRendering()
+{
+    auto d = m_data.get();
+
+    if ( d->renderStart < 0 )
+        return;
+
+    const auto end = timestamp();
+    addEvent( RenderPhase, qskPhaseNames[ RenderPhase ], d->renderStart, end );
+
+    QMutexLocker locker( &d->mutex );
+
+    d->currentFrame.times[ RenderPhase ] = end - d->renderStart;
+    d->frames.append( d->currentFrame );
+
+    d->currentFrame = qskEmptyFrame();
+    d->renderStart = -1;
+}
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_FRAME_PROFILER_H
+#define QSK_FRAME_PROFILER_H
+
+#include "QskGlobal.h"
+
+#include <QByteArray>
+#include <QVector>
+
+#include <memory>
+
+class QQuickWindow;
+class QMetaObject;
+
+/*
+    QskFrameProfiler measures where the time of the frames of a window
+    goes. It is enabled by QskWindow::setProfiling() and records:
+
+    - PolishPhase:    polishing of the controls, per class
+    - AnimationPhase: advancing the animators
+    - SyncPhase:      synchronizing the scene graph, updatePaintNode per class
+    - RenderPhase:    rendering of the scene graph
+
+    As long as no window is profiling, the hooks are reduced to checking
+    a global counter.
+ */
+
+class QSK_EXPORT QskFrameProfiler
+{
+public:
+    enum Phase
+    {
+        PolishPhase,
+        AnimationPhase,
+        SyncPhase,
+        RenderPhase
+    };
+
+    enum { PhaseCount = RenderPhase + 1 };
+
+    class Frame
+    {
+    public:
+        qint64 times[ PhaseCount ]; // usecs
+
+        int createdNodes;
+        int deletedNodes;
+    };
+
+    class ClassTiming
+    {
+    public:
+        const char* className;
+
+        int count;
+        qint64 time; // usecs
+    };
+
+    class QSK_EXPORT Scope
+    {
+    public:
+        Scope( QskFrameProfiler*, Phase, const QMetaObject* );
+        Scope( QskFrameProfiler*, Phase, const char* name );
+        ~Scope();
+
+    private:
+        QskFrameProfiler* m_profiler;
+        const char* m_name;
+        Phase m_phase;
+        qint64 m_start;
+    };
+
+    QskFrameProfiler( QQuickWindow* );
+    ~QskFrameProfiler();
+
+    void setEnabled( bool );
+    bool isEnabled() const;
+
+    void reset();
+
+    // the most recent frames, the last one is the latest
+    void setFrameCapacity( int );
+    int frameCapacity() const;
+
+    QVector< Frame > frames() const;
+
+    // number of frames per bucket of bucketSize usecs, the last bucket has the rest
+    QVector< int > histogram( Phase, int bucketSize = 1000, int bucketCount = 34 ) const;
+
+    // PolishPhase and SyncPhase are recorded per class
+    QVector< ClassTiming > classTimings( Phase ) const;
+
+    // Trace Event Format, like being loaded by chrome://tracing
+    QByteArray chromeTrace() const;
+
+    static bool isActive();
+    static void countNodes( int created, int deleted );
+
+private:
+    void addEvent( Phase, const char* name, qint64 start, qint64 end );
+    qint64 timestamp() const;
+
+    void startSync();
+    void finishSync();
+    void startRendering();
+    void finishRendering();
+    void finishPolishing();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -4,31 +4,27 @@
 #include <QQuickItem>
 #include <QCoreApplication>
 #include <QBasicTimer>
-#include <QScopedPointer>
 #include <QMouseEvent>
+#include <QDebug>
 
 QSK_QT_PRIVATE_BEGIN
-#include <private/qquickwindow_p.h>
+#include <private/qguiapplication_p.h>
 QSK_QT_PRIVATE_END
 
-static inline QMouseEvent* qskClonedMouseEvent(
-    const QMouseEvent* mouseEvent, const QQuickItem* item = nullptr )
+static inline QMouseEvent qskMappedMouseEvent(
+    const QMouseEvent* event, const QQuickItem* item )
 {
-    QMouseEvent* clonedEvent;
-    QMouseEvent* event = const_cast< QMouseEvent* >( mouseEvent );
+    // a copy with the local position translated into item coordinates
 
-    if ( item )
-    {
-        QPointF localPos = item->mapFromScene( event->windowPos() );
-        clonedEvent = QQuickWindowPrivate::cloneMouseEvent( event, &localPos );
-    }
-    else
-    {
-        clonedEvent = QQuickWindowPrivate::cloneMouseEvent( event, nullptr );
-    }
+    QMouseEvent mappedEvent( event->type(),
+        item->mapFromScene( event->windowPos() ), event->windowPos(),
+        event->screenPos(), event->button(), event->buttons(), event->modifiers() );
 
-    clonedEvent->setAccepted( false );
-    return clonedEvent;
+    mappedEvent.setTimestamp( event->timestamp() );
+    QGuiApplicationPrivate::setMouseEventSource( &mappedEvent, event->source() );
+
+    mappedEvent.setAccepted( false );
+    return mappedEvent;
 }
 
 namespace
@@ -83,19 +79,92 @@ namespace
         QskGestureRecognizer* m_recognizer;
     };
 
-    class PendingEvents : public QVector< QMouseEvent* >
+    /*
+        The events of the sequence, that need to be replayed, when
+        rejecting. Intermediate moves are dropped, when running out of
+        space, so that we never have to allocate memory for them.
+     */
+    class PendingEvents
     {
     public:
-        ~PendingEvents()
+        PendingEvents():
+            m_count( 0 )
+        {
+        }
+
+        inline void reset()
+        {
+            m_count = 0;
+        }
+
+        inline int count() const
+        {
+            return m_count;
+        }
+
+        inline QEvent::Type typeAt( int index ) const
         {
-            qDeleteAll( *this );
+            return m_records[ index ].type;
         }
 
-        void reset()
+        void append( const QMouseEvent* event )
         {
-            qDeleteAll( *this );
-            clear();
+            if ( m_count == Capacity )
+            {
+                /*
+                    As the sequence ends with the release the last
+                    record is a move, that can be replaced
+                 */
+                m_count--;
+            }
+
+            auto& r = m_records[ m_count++ ];
+
+            r.type = event->type();
+            r.button = event->button();
+            r.buttons = event->buttons();
+            r.modifiers = event->modifiers();
+            r.source = event->source();
+            r.windowPos = event->windowPos();
+            r.screenPos = event->screenPos();
+            r.timestamp = event->timestamp();
+        }
+
+        QMouseEvent eventAt( int index ) const
+        {
+            // replayed events are sent to the window
+
+            const auto& r = m_records[ index ];
+
+            QMouseEvent event( r.type, r.windowPos, r.windowPos,
+                r.screenPos, r.button, r.buttons, r.modifiers );
+
+            event.setTimestamp( r.timestamp );
+            QGuiApplicationPrivate::setMouseEventSource( &event, r.source );
+
+            event.setAccepted( false );
+            return event;
         }
+
+    private:
+        enum { Capacity = 16 };
+
+        struct Record
+        {
+            QEvent::Type type;
+            Qt::MouseButton button;
+            Qt::MouseButtons buttons;
+            Qt::KeyboardModifiers modifiers;
+            Qt::MouseEventSource source;
+
+            QPointF windowPos;
+            QPointF screenPos;
+
+            ulong timestamp;
+        };
+
+        Record m_records[ Capacity ];
+        int m_count;
     };
 }
 
@@ -108,7 +177,9 @@ public:
         timeout( -1 ),
         buttons( Qt::NoButton ),
         state( QskGestureRecognizer::Idle ),
-        isReplayingEvents( false )
+        isReplayingEvents( false ),
+        isSpeculative( false ),
+        isSpeculating( false )
     {
     }
 
@@ -123,6 +194,9 @@ public:
 
     int state : 4;
     bool isReplayingEvents : 1; // not exception safe !!!
+
+    bool isSpeculative : 1;
+    bool isSpeculating : 1; // the child has the grab, while being pending
 };
 
 QskGestureRecognizer::QskGestureRecognizer():
@@ -165,6 +239,16 @@ int QskGestureRecognizer::timeout() const
     return m_data->timeout;
 }
 
+void QskGestureRecognizer::setSpeculative( bool on )
+{
+    m_data->isSpeculative = on;
+}
+
+bool QskGestureRecognizer::isSpeculative() const
+{
+    return m_data->isSpeculative;
+}
+
 ulong QskGestureRecognizer::timestamp() const
 {
     return m_data->timestamp;
@@ -212,10 +296,17 @@ bool QskGestureRecognizer::processEvent(
         return false;
     }
 
-    QScopedPointer< QMouseEvent > clonedPress;
-
     if ( event->type() == QEvent::MouseButtonPress )
     {
+        if ( m_data->isSpeculating )
+        {
+            /*
+                The child did not accept the press, that has been passed
+                through, and now it is delivered to one of its parents.
+             */
+            reset();
+        }
+
         if ( m_data->state != Idle )
         {
             // should not happen, when using the recognizer correctly
@@ -245,37 +336,23 @@ bool QskGestureRecognizer::processEvent(
         if ( !( buttons & mouseEvent->button() ) )
             return false;
 
-        /*
-            We grab the mouse for watchedItem and indicate, that we want
-            to keep it. From now on all mouse events should end up at watchedItem.
-         */
-        watchedItem->grabMouse();
-        watchedItem->setKeepMouseGrab( true );
-
         m_data->timestamp = mouseEvent->timestamp();
 
-        if ( item != watchedItem )
+        const bool speculate = m_data->isSpeculative
+            && ( item != watchedItem ) && ( m_data->timeout != 0 );
+
+        if ( !speculate )
         {
             /*
-                The first press happens before having the mouse grab and might
-                have been for a child of watchedItem. Then we create a clone
-                of the event with positions translated into the coordinate system
-                of watchedItem.
+                We grab the mouse for watchedItem and indicate, that we want
+                to keep it. From now on all mouse events should end up at watchedItem.
              */
-
-            clonedPress.reset( qskClonedMouseEvent( mouseEvent, watchedItem ) );
-
-            item = watchedItem;
-            event = clonedPress.data();
+            watchedItem->grabMouse();
+            watchedItem->setKeepMouseGrab( true );
         }
 
         if ( m_data->timeout != 0 )
         {
-            /*
-                We need to be able to replay the press in case we later find
-                out, that we don't want to handle the mouse event sequence,
-             */
-
             if ( m_data->timeout > 0 )
                 Timer::instance()->start( m_data->timeout, this );
 
@@ -285,25 +362,84 @@ bool QskGestureRecognizer::processEvent(
         {
             setState( Accepted );
         }
+
+        if ( item == watchedItem )
+        {
+            m_data->pendingEvents.append( mouseEvent );
+            pressEvent( mouseEvent );
+
+            return true;
+        }
+
+        /*
+            The first press happens before having the mouse grab and might
+            have been for a child of watchedItem. Then we use a copy
+            of the event with positions translated into the coordinate system
+            of watchedItem.
+         */
+
+        const auto mappedEvent = qskMappedMouseEvent( mouseEvent, watchedItem );
+
+        if ( speculate )
+        {
+            /*
+                The press is passed to the child without any delay. When
+                the gesture is accepted later we take over the grab, what
+                cancels the interaction of the child.
+             */
+            m_data->isSpeculating = true;
+            pressEvent( &mappedEvent );
+
+            return false;
+        }
+
+        /*
+            We need to be able to replay the press in case we later find
+            out, that we don't want to handle the mouse event sequence,
+         */
+        m_data->pendingEvents.append( &mappedEvent );
+        pressEvent( &mappedEvent );
+
+        return true;
     }
 
-    if ( ( item == watchedItem ) && ( m_data->state > Idle ) )
+    if ( m_data->isSpeculating && ( item != watchedItem ) )
     {
         switch( event->type() )
         {
-            case QEvent::MouseButtonPress:
+            case QEvent::MouseMove:
             {
-                auto mouseEvent = static_cast< QMouseEvent* >( event );
-                m_data->pendingEvents += qskClonedMouseEvent( mouseEvent );
+                const auto mappedEvent = qskMappedMouseEvent(
+                    static_cast< QMouseEvent* >( event ), watchedItem );
 
-                pressEvent( mouseEvent );
-                return true;
+                moveEvent( &mappedEvent );
+
+                // when being accepted the child has lost its grab
+                return m_data->state == Accepted;
+            }
+
+            case QEvent::MouseButtonRelease:
+            {
+                // the child has a complete sequence
+                reset();
+                return false;
             }
 
+            default:
+                return false;
+        }
+    }
+
+    if ( ( item == watchedItem ) && ( m_data->state > Idle ) )
+    {
+        switch( event->type() )
+        {
             case QEvent::MouseMove:
             {
                 auto mouseEvent = static_cast< QMouseEvent* >( event );
-                m_data->pendingEvents += qskClonedMouseEvent( mouseEvent );
+
+                if ( m_data->state == Pending )
+                    m_data->pendingEvents.append( mouseEvent );
 
                 moveEvent( mouseEvent );
                 return true;
@@ -312,10 +448,10 @@ bool QskGestureRecognizer::processEvent(
             case QEvent::MouseButtonRelease:
             {
                 auto mouseEvent = static_cast< QMouseEvent* >( event );
-                m_data->pendingEvents += qskClonedMouseEvent( mouseEvent );
 
                 if ( m_data->state == Pending )
                 {
+                    m_data->pendingEvents.append( mouseEvent );
                     reject();
                 }
                 else
@@ -364,13 +500,32 @@ void QskGestureRecognizer::accept()
     Timer::instance()->stop( this );
     m_data->pendingEvents.reset();
 
+    if ( m_data->isSpeculating )
+    {
+        m_data->isSpeculating = false;
+
+        /*
+            Taking over the grab sends an UngrabMouse to the child,
+            what is the established way to cancel its interaction.
+         */
+        m_data->watchedItem->grabMouse();
+        m_data->watchedItem->setKeepMouseGrab( true );
+    }
+
     setState( Accepted );
 }
 
 void QskGestureRecognizer::reject()
 {
-    const auto events = m_data->pendingEvents;
-    m_data->pendingEvents.clear();
+    if ( m_data->isSpeculating )
+    {
+        // the events have been delivered to the child already
+        reset();
+        return;
+    }
+
+    // a flat copy, as replaying might start a new sequence
+    const PendingEvents events = m_data->pendingEvents;
 
     reset();
 
@@ -381,9 +536,10 @@ void QskGestureRecognizer::reject()
     if ( window->mouseGrabberItem() == m_data->watchedItem )
         m_data->watchedItem->ungrabMouse();
 
-    if ( !events.isEmpty() && events[0]->type() == QEvent::MouseButtonPress )
+    if ( events.count() > 0 && events.typeAt( 0 ) == QEvent::MouseButtonPress )
     {
-        QCoreApplication::sendEvent( window, events[0] );
+        auto pressEvent = events.eventAt( 0 );
+        QCoreApplication::sendEvent( window, &pressEvent );
 
         /*
             After resending the initial press someone else
@@ -392,8 +548,11 @@ void QskGestureRecognizer::reject()
 
         if ( window->mouseGrabberItem() )
         {
-            for ( int i = 1; i < events.size(); i++ )
-                QCoreApplication::sendEvent( window, events[i] );
+            for ( int i = 1; i < events.count(); i++ )
+            {
+                auto event = events.eventAt( i );
+                QCoreApplication::sendEvent( window, &event );
+            }
         }
     }
 
@@ -412,6 +571,7 @@ void QskGestureRecognizer::reset()
     m_data->pendingEvents.reset();
 
     m_data->timestamp = 0;
+    m_data->isSpeculating = false;
 
     setState( Idle );
 }
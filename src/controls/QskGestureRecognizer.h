@@ -37,6 +37,15 @@ public:
     void setTimeout( int );
     int timeout() const;
 
+    /*
+        In speculative mode a press on a child is delivered immediately
+        instead of being replayed after the timeout. When the gesture is
+        accepted the recognizer takes over the mouse grab, what sends
+        an UngrabMouse to the child.
+     */
+    void setSpeculative( bool );
+    bool isSpeculative() const;
+
     ulong timestamp() const;
 
     bool processEvent( QQuickItem*, QEvent*, bool blockReplayedEvents = true );
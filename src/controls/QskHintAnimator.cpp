@@ -6,6 +6,7 @@
 #include "QskHintAnimator.h"
 #include "QskAnimationHint.h"
 #include "QskControl.h"
+#include "QskSkinlet.h"
 #include "QskEvent.h"
 #include "QskMargins.h"
 #include "QskBoxBorderMetrics.h"
@@ -116,15 +117,23 @@ void QskHintAnimator::setControl( QskControl* control )
 
 void QskHintAnimator::advance( qreal progress )
 {
-    const QVariant oldValue = currentValue();
-
-    Inherited::advance( progress );
+    /*
+        Holding a copy of the previous value would force the
+        current value to detach for each step. So we let
+        the interpolation tell us about changes instead.
+     */
+    bool isChanged = interpolate( progress );
 
 #if ALIGN_VALUES
-    setCurrentValue( qskAligned05( currentValue() ) );
+    const auto alignedValue = qskAligned05( currentValue() );
+    if ( alignedValue != currentValue() )
+    {
+        setCurrentValue( alignedValue );
+        isChanged = true;
+    }
 #endif
 
-    if ( m_control && ( currentValue() != oldValue ) )
+    if ( m_control && isChanged )
     {
         if ( m_aspect.type() == QskAspect::Metric )
         {
@@ -132,7 +141,8 @@ void QskHintAnimator::advance( qreal progress )
             m_control->polish();
         }
 
-        m_control->update();
+        const auto skinlet = m_control->effectiveSkinlet();
+        m_control->updateNodeRoles( skinlet->nodeRoleMask( m_aspect ) );
     }
 }
 
@@ -48,6 +48,7 @@ public:
     const QskHintAnimator* animator( QskAspect::Aspect aspect ) const;
     QVariant currentValue( QskAspect::Aspect ) const;
 
+    bool isEmpty() const;
     bool cleanup();
 
 private:
@@ -62,6 +63,12 @@ inline QskAspect::Aspect QskHintAnimator::aspect() const
     return m_aspect;
 }
 
+inline bool QskHintAnimatorTable::isEmpty() const
+{
+    // m_data is deleted, when the last animator has been removed
+    return m_data == nullptr;
+}
+
 inline QskControl* QskHintAnimator::control() const
 {
     return m_control;
@@ -5,7 +5,7 @@
 
 #include "QskResizable.h"
 
-// QGridLayoutEngine internally uses FLT_MAX
+// the same as QskLayoutConstraint::unlimited
 static constexpr qreal c_max = std::numeric_limits< float >::max();
 
 QskResizable::QskResizable():
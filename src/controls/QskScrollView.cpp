@@ -116,7 +116,8 @@ public:
         scrollableSize( 0.0, 0.0 ),
         panRecognizerTimeout( 100 ), // value coming from the platform ???
         viewportPadding( 10 ),
-        isScrolling( 0 )
+        isScrolling( 0 ),
+        hasPendingScrollPos( false )
     {
     }
 
@@ -136,6 +137,14 @@ public:
 
     qreal scrollPressPos;
     int isScrolling;
+
+    /*
+        Input devices might deliver several events per frame. Instead of
+        updating for each of them we apply the most recent position,
+        when being polished.
+     */
+    bool hasPendingScrollPos;
+    QPointF pendingScrollPos;
 };
 
 QskScrollView::QskScrollView( QQuickItem* parent ):
@@ -172,6 +181,16 @@ int QskScrollView::flickRecognizerTimeout() const
     return m_data->panRecognizerTimeout;
 }
 
+void QskScrollView::setFlickRecognizerSpeculative( bool on )
+{
+    m_data->panRecognizer.setSpeculative( on );
+}
+
+bool QskScrollView::isFlickRecognizerSpeculative() const
+{
+    return m_data->panRecognizer.isSpeculative();
+}
+
 void QskScrollView::setFlickableOrientations( Qt::Orientations orientations )
 {
     if ( m_data->panRecognizer.orientations() != orientations )
@@ -220,6 +239,8 @@ Qt::ScrollBarPolicy QskScrollView::horizontalScrollBarPolicy() const
 
 void QskScrollView::setScrollPos( const QPointF& pos )
 {
+    m_data->hasPendingScrollPos = false;
+
     const QPointF boundedPos = boundedScrollPos( pos );
     if ( boundedPos != m_data->scrollPos )
     {
@@ -383,15 +404,16 @@ void QskScrollView::mousePressEvent( QMouseEvent* event )
         else
         {
             const QRectF vRect = viewContentsRect();
+            const QPointF pos = pendingScrollPos();
 
-            qreal y = m_data->scrollPos.y();
+            qreal y = pos.y();
 
             if ( event->y() < handleRect.top() )
                 y -= vRect.height();
             else
                 y += vRect.height();
 
-            setScrollPos( QPointF( m_data->scrollPos.x(), y ) );
+            requestScrollPos( QPointF( pos.x(), y ) );
         }
 
         return;
@@ -411,15 +433,16 @@ void QskScrollView::mousePressEvent( QMouseEvent* event )
         else
         {
             const QRectF vRect = viewContentsRect();
+            const QPointF pos = pendingScrollPos();
 
-            qreal x = m_data->scrollPos.x();
+            qreal x = pos.x();
 
             if ( event->x() < handleRect.left() )
                 x -= vRect.width();
             else
                 x += vRect.width();
 
-            setScrollPos( QPointF( x, m_data->scrollPos.y() ) );
+            requestScrollPos( QPointF( x, pos.y() ) );
         }
     }
 }
@@ -432,7 +455,7 @@ void QskScrollView::mouseMoveEvent( QMouseEvent* event )
         return;
     }
 
-    QPointF pos = m_data->scrollPos;
+    QPointF pos = pendingScrollPos();
 
     if ( m_data->isScrolling == Qt::Horizontal )
     {
@@ -451,8 +474,7 @@ void QskScrollView::mouseMoveEvent( QMouseEvent* event )
         m_data->scrollPressPos = event->y();
     }
 
-    if ( pos != m_data->scrollPos )
-        setScrollPos( pos );
+    requestScrollPos( pos );
 }
 
 void QskScrollView::mouseReleaseEvent( QMouseEvent* )
@@ -476,11 +498,14 @@ void QskScrollView::gestureEvent( QskGestureEvent* event )
         {
             case QskGesture::Updated:
             {
-                setScrollPos( scrollPos() - gesture->delta() );
+                requestScrollPos( pendingScrollPos() - gesture->delta() );
                 break;
             }
             case QskGesture::Finished:
             {
+                if ( m_data->hasPendingScrollPos )
+                    setScrollPos( m_data->pendingScrollPos );
+
                 m_data->flicker.setWindow( window() );
                 m_data->flicker.accelerate( gesture->angle(), gesture->velocity() );
                 break;
@@ -544,7 +569,7 @@ void QskScrollView::wheelEvent( QWheelEvent* event )
             offset = -offset;
 #endif
 
-        setScrollPos( m_data->scrollPos - offset );
+        requestScrollPos( pendingScrollPos() - offset );
     }
 }
 
@@ -598,6 +623,9 @@ bool QskScrollView::gestureFilter( QQuickItem* item, QEvent* event )
         But if a child does not accept a mouse event it will be sent to
         its parent. So we might finally receive the reposted events, but then
         we can proceed as in b).
+
+        In speculative mode the child receives the press of a) immediately
+        and loses its grab, when the recognizer accepts the gesture later.
      */
 
     auto& recognizer = m_data->panRecognizer;
@@ -616,6 +644,45 @@ bool QskScrollView::gestureFilter( QQuickItem* item, QEvent* event )
     return m_data->panRecognizer.processEvent( item, event );
 }
 
+void QskScrollView::updateLayout()
+{
+    if ( m_data->hasPendingScrollPos )
+        setScrollPos( m_data->pendingScrollPos );
+
+    Inherited::updateLayout();
+}
+
+QPointF QskScrollView::pendingScrollPos() const
+{
+    return m_data->hasPendingScrollPos
+        ? m_data->pendingScrollPos : m_data->scrollPos;
+}
+
+void QskScrollView::requestScrollPos( const QPointF& pos )
+{
+    if ( window() == nullptr || !isVisible() )
+    {
+        setScrollPos( pos );
+        return;
+    }
+
+    const QPointF boundedPos = boundedScrollPos( pos );
+
+    if ( boundedPos == m_data->scrollPos )
+    {
+        m_data->hasPendingScrollPos = false;
+        return;
+    }
+
+    m_data->pendingScrollPos = boundedPos;
+
+    if ( !m_data->hasPendingScrollPos )
+    {
+        m_data->hasPendingScrollPos = true;
+        polish();
+    }
+}
+
 QPointF QskScrollView::boundedScrollPos( const QPointF& pos ) const
 {
     const QRectF vr = viewContentsRect();
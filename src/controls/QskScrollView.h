@@ -47,6 +47,10 @@ public:
     int flickRecognizerTimeout() const;
     void setFlickRecognizerTimeout( int timeout );
 
+    // children receive the press without delay, see QskGestureRecognizer
+    bool isFlickRecognizerSpeculative() const;
+    void setFlickRecognizerSpeculative( bool );
+
     QPointF scrollPos() const;
     bool isScrolling( Qt::Orientation ) const;
 
@@ -84,12 +88,16 @@ protected:
 #endif
 
     virtual bool gestureFilter( QQuickItem*, QEvent* ) override;
+    virtual void updateLayout() override;
 
     void setScrollableSize( const QSizeF& );
 
 private:
     QPointF boundedScrollPos( const QPointF& ) const;
 
+    QPointF pendingScrollPos() const;
+    void requestScrollPos( const QPointF& );
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
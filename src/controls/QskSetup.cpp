@@ -12,7 +12,6 @@
 #include "QskObjectTree.h"
 
 #include <QGuiApplication>
-#include <QStyleHints>
 
 #include <QPointer>
 #include <QDebug>
@@ -67,16 +66,13 @@ static void qskApplicationHook()
     qAddPostRoutine( QskSetup::cleanup );
 }
 
-static void qskApplicationFilter()
-{
-    QCoreApplication::instance()->installEventFilter( QskSetup::instance() );
-}
-
 Q_CONSTRUCTOR_FUNCTION( qskApplicationHook )
-Q_COREAPP_STARTUP_FUNCTION( qskApplicationFilter )
 
 extern bool qskInheritLocale( QskControl*, const QLocale& );
 extern bool qskInheritLocale( QskWindow*, const QLocale& );
+extern void qskUpdateSkin( const QskSkin*, const QskSkin* );
+extern qint64 qskLayerCacheUsage();
+extern void qskUpdatePendingLayers();
 
 namespace
 {
@@ -117,7 +113,8 @@ class QskSetup::PrivateData
 {
 public:
     PrivateData():
-        controlFlags( qskDefaultControlFlags() )
+        controlFlags( qskDefaultControlFlags() ),
+        layerCacheLimit( 32 * 1024 * 1024 )
     {
     }
 
@@ -128,6 +125,7 @@ public:
 
     QPointer< QQuickItem > inputPanel;
     QskSetup::Flags controlFlags;
+    qint64 layerCacheLimit;
 };
 
 QskSetup::QskSetup():
@@ -197,6 +195,25 @@ bool QskSetup::testControlFlag( QskSetup::Flag flag )
     return m_data->controlFlags.testFlag( flag );
 }
 
+void QskSetup::setLayerCacheLimit( qint64 bytes )
+{
+    // layers, that are already enabled, are not affected
+    m_data->layerCacheLimit = qMax( bytes, qint64( 0 ) );
+
+    // controls, that have been denied a layer, might fit now
+    qskUpdatePendingLayers();
+}
+
+qint64 QskSetup::layerCacheLimit() const
+{
+    return m_data->layerCacheLimit;
+}
+
+qint64 QskSetup::layerCacheUsage() const
+{
+    return qskLayerCacheUsage();
+}
+
 QskSkin* QskSetup::setSkin( const QString& skinName )
 {
     if ( m_data->skin && ( skinName == m_data->skinName ) )
@@ -216,6 +233,7 @@ QskSkin* QskSetup::setSkin( const QString& skinName )
 
     if ( oldSkin )
     {
+        qskUpdateSkin( oldSkin, skin );
         Q_EMIT skinChanged( skin );
 
         if ( oldSkin->parent() == this )
@@ -293,75 +311,6 @@ void QskSetup::inheritLocale( QObject* object, const QLocale& locale )
     QskObjectTree::traverseDown( object, visitor );
 }
 
-bool QskSetup::eventFilter( QObject* object, QEvent* event )
-{
-    if ( auto control = qobject_cast< QskControl* >( object ) )
-    {
-        /*
-            Qt::FocusPolicy has always been there with widgets, got lost with
-            Qt/Quick and has been reintroduced with Qt/Quick Controls 2 ( QC2 ).
-            Unfortunately this was done once more by adding code on top instead
-            of fixing the foundation.
-
-            But we also don't want to have how it is done in QC2 by adding
-            the focus management in the event handler of the base class.
-            This implementation reverts the expected default behaviour of when
-            events are accepted/ignored + is an error prone nightmare, when it
-            comes to overloading event handlers missing to call the base class.
-
-            That's why we prefer to do the focus management outside of the
-            event handlers.
-         */
-        switch( event->type() )
-        {
-            case QEvent::MouseButtonPress:
-            case QEvent::MouseButtonRelease:
-            {
-                if ( ( control->focusPolicy() & Qt::ClickFocus ) == Qt::ClickFocus )
-                {
-                    const bool focusOnRelease =
-                        QGuiApplication::styleHints()->setFocusOnTouchRelease();
-
-                    if ( focusOnRelease )
-                    {
-                        if ( event->type() == QEvent::MouseButtonRelease )
-                            control->forceActiveFocus( Qt::MouseFocusReason );
-                    }
-                    else
-                    {
-                        if ( event->type() == QEvent::MouseButtonPress )
-                            control->forceActiveFocus( Qt::MouseFocusReason );
-                    }
-                }
-                break;
-            }
-            case QEvent::Wheel:
-            {
-                if ( !control->isWheelEnabled() )
-                {
-                    /*
-                        We block further processing of the event. This is in line
-                        with not receiving any mouse event that have not been
-                        explicitly enabled with setAcceptedMouseButtons().
-
-                     */
-                    event->ignore();
-                    return true;
-                }
-
-                if ( ( control->focusPolicy() & Qt::WheelFocus ) == Qt::WheelFocus )
-                    control->forceActiveFocus( Qt::MouseFocusReason );
-
-                break;
-            }
-            default:
-                break;
-        }
-    }
-
-    return false;
-}
-
 QskSetup* QskSetup::qmlAttachedProperties( QObject* )
 {
     return QskSetup::instance();
@@ -36,6 +36,8 @@ public:
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        CullOutsideWindow       =  1 << 5,
+        ConcurrentLayout        =  1 << 6,
 
         DebugForceBackground    =  1 << 7
     };
@@ -53,6 +55,11 @@ public:
     Q_INVOKABLE void resetControlFlag( Flag );
     Q_INVOKABLE bool testControlFlag( Flag );
 
+    // memory for the textures of controls being cached as layer
+    Q_INVOKABLE void setLayerCacheLimit( qint64 bytes );
+    Q_INVOKABLE qint64 layerCacheLimit() const;
+    Q_INVOKABLE qint64 layerCacheUsage() const;
+
     Q_INVOKABLE QskSkin* setSkin( const QString& );
     Q_INVOKABLE QString skinName() const;
 
@@ -81,8 +88,6 @@ private:
     QskSetup();
     virtual ~QskSetup();
 
-    virtual bool eventFilter( QObject*, QEvent* ) override final;
-
     static QskSetup* s_instance;
 
     class PrivateData;
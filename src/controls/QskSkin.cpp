@@ -110,9 +110,39 @@ public:
     {
     }
 
+    SkinletData* skinletData( const QMetaObject* metaObject )
+    {
+        const auto resolved = resolvedSkinlets.find( metaObject );
+        if ( resolved != resolvedSkinlets.cend() )
+            return resolved->second;
+
+        SkinletData* data = nullptr;
+
+        for ( auto mo = metaObject; mo != nullptr; mo = mo->superClass() )
+        {
+            auto it = skinletMap.find( mo );
+            if ( it != skinletMap.cend() )
+            {
+                data = &it->second;
+                break;
+            }
+        }
+
+        resolvedSkinlets.emplace( metaObject, data );
+        return data;
+    }
+
     QskSkin* skin;
     std::unordered_map< const QMetaObject*, SkinletData > skinletMap;
 
+    /*
+        The entries of skinletMap for the classes of the skinnables,
+        so that we don't need to walk up the class hierarchy each time.
+        As the nodes of an unordered_map are never moved, we can
+        keep pointers to them.
+     */
+    std::unordered_map< const QMetaObject*, SkinletData* > resolvedSkinlets;
+
     QskSkinHintTable hintTable;
 
     std::unordered_map< int, QFont > fonts;
@@ -313,6 +343,9 @@ void QskSkin::declareSkinlet( const QMetaObject* metaObject,
     else
     {
         m_data->skinletMap.emplace( metaObject, skinletMetaObject );
+
+        // subclasses might be resolved to the new entry now
+        m_data->resolvedSkinlets.clear();
     }
 }
 
@@ -438,28 +471,31 @@ const int* QskSkin::dialogButtonLayout( Qt::Orientation orientation ) const
 
 QskSkinlet* QskSkin::skinlet( const QskSkinnable* skinnable )
 {
-    for ( auto metaObject = skinnable->metaObject();
-        metaObject != nullptr; metaObject = metaObject->superClass() )
+    if ( auto entry = m_data->skinletData( skinnable->metaObject() ) )
     {
-        auto it = m_data->skinletMap.find( metaObject );
-        if ( it != m_data->skinletMap.cend() )
+        if ( entry->skinlet == nullptr )
         {
-            auto& entry = it->second;
-
-            if ( entry.skinlet == nullptr )
-            {
-                entry.skinlet = reinterpret_cast< QskSkinlet* >(
-                    entry.metaObject->newInstance( Q_ARG( QskSkin*, this ) ) );
-            }
-
-            return entry.skinlet;
+            entry->skinlet = reinterpret_cast< QskSkinlet* >(
+                entry->metaObject->newInstance( Q_ARG( QskSkin*, this ) ) );
         }
+
+        return entry->skinlet;
     }
 
     static QskSkinlet defaultSkinlet;
     return &defaultSkinlet;
 }
 
+const QMetaObject* QskSkin::skinletMetaObject( const QskSkinnable* skinnable ) const
+{
+    // the class of the skinlet, without creating it
+
+    if ( auto entry = m_data->skinletData( skinnable->metaObject() ) )
+        return entry->metaObject;
+
+    return &QskSkinlet::staticMetaObject;
+}
+
 void QskSkin::resetColors( const QColor& )
 {
 }
@@ -121,6 +121,7 @@ public:
     virtual const int *dialogButtonLayout( Qt::Orientation ) const;
 
     QskSkinlet* skinlet( const QskSkinnable* );
+    const QMetaObject* skinletMetaObject( const QskSkinnable* ) const;
 
     const QskSkinHintTable& hintTable() const;
 
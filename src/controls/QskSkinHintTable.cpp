@@ -44,108 +44,110 @@ inline const QVariant* qskResolvedHint( QskAspect::Aspect aspect,
 }
 
 QskSkinHintTable::QskSkinHintTable():
-    m_hints( nullptr ),
     m_animatorCount( 0 ),
     m_hasStates( false )
 {
 }
 
 QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other ):
-    m_hints( nullptr ),
+    m_hints( other.m_hints ),
     m_animatorCount( other.m_animatorCount ),
     m_hasStates( other.m_hasStates )
 {
-    if ( other.m_hints )
-        m_hints = new HintMap( *(other.m_hints) );
 }
 
 QskSkinHintTable::~QskSkinHintTable()
 {
-    delete m_hints;
 }
 
 QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
 {
+    m_hints = other.m_hints;
     m_animatorCount = other.m_animatorCount;
     m_hasStates = other.m_hasStates;
 
-    if ( other.m_hints )
-    {
-        if ( m_hints == nullptr )
-            m_hints = new HintMap();
-
-        *m_hints = *other.m_hints;
-    }
-    else
-    {
-        delete m_hints;
-        m_hints = nullptr;
-    }
-
     return *this;
 }
 
 const std::unordered_map< QskAspect::Aspect, QVariant >& QskSkinHintTable::hints() const
 {
     if ( m_hints )
-        return *m_hints;
+        return m_hints->hints;
 
     static std::unordered_map< QskAspect::Aspect, QVariant > dummyHints;
     return dummyHints;
 }
 
+QskSkinHintTable::HintMap& QskSkinHintTable::writableHints()
+{
+    if ( m_hints )
+        m_hints.detach(); // copy on write
+    else
+        m_hints = new SharedHints();
+
+    return m_hints->hints;
+}
+
 void QskSkinHintTable::setHint( QskAspect::Aspect aspect, const QVariant& skinHint )
 {
-    if ( m_hints == nullptr )
-        m_hints = new HintMap();
+    if ( aspect.state() )
+        m_hasStates = true;
+
+    if ( m_hints )
+    {
+        // no need to detach, when nothing changes
+        const auto& hints = m_hints->hints;
+
+        auto it = hints.find( aspect );
+        if ( it != hints.cend() && it->second == skinHint )
+            return;
+    }
+
+    auto& hints = writableHints();
 
-    auto it = m_hints->find( aspect );
-    if ( it == m_hints->end() )
+    auto it = hints.find( aspect );
+    if ( it == hints.end() )
     {
-        m_hints->emplace( aspect, skinHint );
+        hints.emplace( aspect, skinHint );
         if ( aspect.isAnimator() )
             m_animatorCount++;
     }
-    else if ( it->second != skinHint )
+    else
     {
         it->second = skinHint;
     }
-
-    if ( aspect.state() )
-        m_hasStates = true;
 }
 
 void QskSkinHintTable::removeHint( QskAspect::Aspect aspect )
 {
-    if ( m_hints == nullptr )
+    if ( !hasHint( aspect ) )
         return;
 
-    if ( m_hints->erase( aspect ) )
+    if ( m_hints->hints.size() == 1 )
     {
-        if ( aspect.isAnimator() )
-            m_animatorCount--;
-        
-        if ( m_hints->empty() )
-        {
-            delete m_hints;
-            m_hints = nullptr;
-        }
+        // no need to copy the map for removing its last hint
+        m_hints.reset();
     }
+    else
+    {
+        writableHints().erase( aspect );
+    }
+
+    if ( aspect.isAnimator() )
+        m_animatorCount--;
 }
 
 void QskSkinHintTable::clear()
 {
-    delete m_hints;
-    m_hints = nullptr;
-
+    m_hints.reset();
     m_animatorCount = 0;
 }
 
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect::Aspect aspect, QskAspect::Aspect* resolvedAspect ) const
 {
-    if ( m_hints != nullptr )
-        return qskResolvedHint( aspect, *m_hints, resolvedAspect );
+    if ( m_hints )
+        return qskResolvedHint( aspect, m_hints->hints, resolvedAspect );
 
     return nullptr;
 }
@@ -154,8 +156,8 @@ QskAspect::Aspect QskSkinHintTable::resolvedAspect( QskAspect::Aspect aspect ) c
 {
     QskAspect::Aspect a;
 
-    if ( m_hints != nullptr )
-        qskResolvedHint( aspect, *m_hints, &a );
+    if ( m_hints )
+        qskResolvedHint( aspect, m_hints->hints, &a );
 
     return a;
 }
@@ -165,10 +167,12 @@ QskAspect::Aspect QskSkinHintTable::resolvedAnimator(
 {
     if ( m_hints && m_animatorCount > 0 )
     {
+        const auto& hints = m_hints->hints;
+
         Q_FOREVER
         {
-            auto it = m_hints->find( aspect );
-            if ( it != m_hints->cend() )
+            auto it = hints.find( aspect );
+            if ( it != hints.cend() )
             {
                 hint = it->second.value< QskAnimationHint >();
                 return aspect;
@@ -183,3 +187,39 @@ QskAspect::Aspect QskSkinHintTable::resolvedAnimator(
 
     return QskAspect::Aspect();
 }
+
+QVector< QskAspect::Aspect > QskSkinHintTable::changedAspects(
+    const QskSkinHintTable& other ) const
+{
+    /*
+        Aspects of all hints, that are missing in one of the tables
+        or have different values. Hints, that can't be compared by
+        QVariant, are reported as changed.
+     */
+
+    QVector< QskAspect::Aspect > aspects;
+
+    if ( m_hints == other.m_hints )
+        return aspects;
+
+    if ( m_hints )
+    {
+        for ( const auto& entry : m_hints->hints )
+        {
+            const auto& otherHint = other.hint( entry.first );
+            if ( !otherHint.isValid() || otherHint != entry.second )
+                aspects += entry.first;
+        }
+    }
+
+    if ( other.m_hints )
+    {
+        for ( const auto& entry : other.m_hints->hints )
+        {
+            if ( !hasHint( entry.first ) )
+                aspects += entry.first;
+        }
+    }
+
+    return aspects;
+}
@@ -17,10 +17,18 @@
 
 #include <QVariant>
 #include <QColor>
+#include <QVector>
+#include <QSharedData>
 
 #include <unordered_map>
 #include <set>
 
+/*
+    The hints are implicitly shared: copies of a table share the same
+    hash map until one of them is modified. So assigning the same table
+    to many skinnables costs only one map.
+ */
+
 class QSK_EXPORT QskSkinHintTable
 {
 public:
@@ -84,11 +92,25 @@ public:
     QskAspect::Aspect resolvedAnimator(
         QskAspect::Aspect, QskAnimationHint& ) const;
 
+    QVector< QskAspect::Aspect > changedAspects( const QskSkinHintTable& ) const;
+
+    // true, when both tables are sharing the same hints
+    bool isSharedWith( const QskSkinHintTable& ) const;
+
 private:
     static QVariant invalidHint;
 
     typedef std::unordered_map< QskAspect::Aspect, QVariant > HintMap;
-    HintMap* m_hints;
+
+    class SharedHints : public QSharedData
+    {
+    public:
+        HintMap hints;
+    };
+
+    HintMap& writableHints();
+
+    QExplicitlySharedDataPointer< SharedHints > m_hints;
 
     quint16 m_animatorCount;
     bool m_hasStates : 1;
@@ -96,7 +118,7 @@ private:
 
 inline bool QskSkinHintTable::hasHints() const
 {
-    return m_hints != nullptr;
+    return m_hints.constData() != nullptr;
 }
 
 inline bool QskSkinHintTable::hasStates() const
@@ -109,20 +131,25 @@ inline bool QskSkinHintTable::hasAnimators() const
     return m_animatorCount;
 }
 
+inline bool QskSkinHintTable::isSharedWith( const QskSkinHintTable& other ) const
+{
+    return m_hints == other.m_hints;
+}
+
 inline bool QskSkinHintTable::hasHint( QskAspect::Aspect aspect ) const
 {
-    if ( m_hints != nullptr )
-        return m_hints->find( aspect ) != m_hints->cend();
+    if ( m_hints )
+        return m_hints->hints.find( aspect ) != m_hints->hints.cend();
 
     return false;
 }
 
 inline const QVariant& QskSkinHintTable::hint( QskAspect::Aspect aspect ) const
 {
-    if ( m_hints != nullptr )
+    if ( m_hints )
     {
-        auto it = m_hints->find( aspect );
-        if ( it != m_hints->cend() )
+        auto it = m_hints->hints.find( aspect );
+        if ( it != m_hints->hints.cend() )
             return it->second;
     }
 
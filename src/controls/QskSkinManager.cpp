@@ -5,6 +5,7 @@
 
 #include "QskSkinManager.h"
 #include "QskSkinFactory.h"
+#include "QskSkin.h"
 
 #include <QGlobalStatic>
 #include <QDir>
@@ -14,6 +15,13 @@
 #include <QMap>
 #include <QSet>
 #include <QPointer>
+#include <QMutex>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+#include <functional>
 
 /*
     We could use QFactoryLoader, but as it is again a "private" class
@@ -92,13 +100,17 @@ namespace
             return m_factoryId;
         }
 
-        inline QskSkinFactory* factory()
+        inline QskSkinFactory* factory( QThread* thread )
         {
             auto factory = qobject_cast< QskSkinFactory* >( QPluginLoader::instance() );
             if ( factory )
             {
                 factory->setParent( nullptr );
                 factory->setObjectName( m_factoryId );
+
+                // the plugin might have been loaded from a worker thread
+                if ( factory->thread() != thread )
+                    factory->moveToThread( thread );
             }
 
             return factory;
@@ -161,7 +173,7 @@ namespace
             m_factoryMap.clear();
         }
 
-        QskSkinFactory* factory( const QString& skinName )
+        QskSkinFactory* factory( const QString& skinName, QThread* thread )
         {
             if ( !m_isValid )
                 rebuild();
@@ -174,7 +186,7 @@ namespace
                 {
                     auto& data = it2.value();
                     if ( ( data.factory == nullptr ) && data.loader != nullptr )
-                        data.factory = data.loader->factory();
+                        data.factory = data.loader->factory( thread );
 
                     return data.factory;
                 }
@@ -313,6 +325,21 @@ namespace
     };
 }
 
+namespace
+{
+    class PreloadedSkin
+    {
+    public:
+        PreloadedSkin():
+            skin( nullptr )
+        {
+        }
+
+        QSemaphore semaphore; // released, when the skin has been created
+        QskSkin* skin;
+    };
+}
+
 class QskSkinManager::PrivateData
 {
 public:
@@ -321,6 +348,53 @@ public:
     {
     }
 
+    ~PrivateData()
+    {
+        for ( auto preloadedSkin : qskAsConst( preloadedSkins ) )
+        {
+            preloadedSkin->semaphore.acquire();
+
+            delete preloadedSkin->skin;
+            delete preloadedSkin;
+        }
+    }
+
+    QskSkin* createSkin( const QString& skinName, QThread* thread )
+    {
+        auto name = skinName;
+        QPointer< QskSkinFactory > f;
+
+        {
+            /*
+                The mutex protects the lookup only. Building the skin
+                might take a while and must not block other threads,
+                that are accessing the manager in the meantime.
+             */
+            QMutexLocker locker( &mutex );
+
+            ensurePlugins();
+
+            f = factoryMap.factory( name, thread );
+            if ( f == nullptr )
+            {
+                /*
+                    Once the Fusion skin has been implemented it will be used
+                    as fallback. For the moment we implement
+                    another stupid fallback. TODO ...
+                 */
+
+                const auto names = factoryMap.skinNames();
+                if ( !names.isEmpty() )
+                {
+                    name = names.last();
+                    f = factoryMap.factory( name, thread );
+                }
+            }
+        }
+
+        return f ? f->createSkin( name ) : nullptr;
+    }
+
     inline void ensurePlugins()
     {
         if ( !pluginsRegistered )
@@ -364,9 +438,49 @@ public:
     QStringList pluginPaths;
     FactoryMap factoryMap;
 
+    /*
+        Skins might be created from a worker thread, see
+        QskSkinManager::preloadSkin
+     */
+    mutable QMutex mutex;
+    QMap< QString, PreloadedSkin* > preloadedSkins;
+
     bool pluginsRegistered : 1;
 };
 
+namespace
+{
+    class PreloadRunnable final : public QRunnable
+    {
+    public:
+        PreloadRunnable( const std::function< QskSkin*() >& createSkin,
+                QThread* thread, PreloadedSkin* preloadedSkin ):
+            m_createSkin( createSkin ),
+            m_thread( thread ),
+            m_preloadedSkin( preloadedSkin )
+        {
+        }
+
+        virtual void run() override final
+        {
+            auto skin = m_createSkin();
+            if ( skin )
+            {
+                // only the thread, that has created the skin, can push it
+                skin->moveToThread( m_thread );
+            }
+
+            m_preloadedSkin->skin = skin;
+            m_preloadedSkin->semaphore.release();
+        }
+
+    private:
+        const std::function< QskSkin*() > m_createSkin;
+        QThread* m_thread;
+        PreloadedSkin* m_preloadedSkin;
+    };
+}
+
 QskSkinManager* QskSkinManager::instance()
 {
     return qskGlobalSkinManager;
@@ -385,6 +499,8 @@ QskSkinManager::~QskSkinManager()
 
 void QskSkinManager::addPluginPath( const QString& path )
 {
+    QMutexLocker locker( &m_data->mutex );
+
     const auto pluginPath = qskResolvedPath( path );
 
     if ( !pluginPath.isEmpty() && !pluginPath.contains( pluginPath ) )
@@ -398,6 +514,8 @@ void QskSkinManager::addPluginPath( const QString& path )
 
 void QskSkinManager::removePluginPath( const QString& path )
 {
+    QMutexLocker locker( &m_data->mutex );
+
     const auto pluginPath = qskResolvedPath( path );
 
     if ( m_data->pluginPaths.removeOne( pluginPath ) )
@@ -412,6 +530,8 @@ void QskSkinManager::removePluginPath( const QString& path )
 
 void QskSkinManager::setPluginPaths( const QStringList& paths )
 {
+    QMutexLocker locker( &m_data->mutex );
+
     m_data->pluginPaths.clear();
 
     QSet< QString > pathSet; // checking for duplicates
@@ -437,6 +557,7 @@ void QskSkinManager::setPluginPaths( const QStringList& paths )
 
 QStringList QskSkinManager::pluginPaths() const
 {
+    QMutexLocker locker( &m_data->mutex );
     return m_data->pluginPaths;
 }
 
@@ -451,6 +572,7 @@ void QskSkinManager::registerFactory(
         to check the plugins here.
      */
 
+    QMutexLocker locker( &m_data->mutex );
     m_data->factoryMap.insertFactory( factoryId.toLower(), factory );
 }
 
@@ -464,42 +586,72 @@ void QskSkinManager::unregisterFactory( const QString& factoryId )
         to know about them here.
      */
 
+    QMutexLocker locker( &m_data->mutex );
+
     m_data->ensurePlugins();
     m_data->factoryMap.removeFactory( factoryId.toLower() );
 }
 
 QStringList QskSkinManager::skinNames() const
 {
+    QMutexLocker locker( &m_data->mutex );
+
     m_data->ensurePlugins();
     return m_data->factoryMap.skinNames();
 }
 
 QskSkin* QskSkinManager::createSkin( const QString& skinName ) const
 {
-    m_data->ensurePlugins();
+    PreloadedSkin* preloadedSkin = nullptr;
+
+    {
+        QMutexLocker locker( &m_data->mutex );
+        preloadedSkin = m_data->preloadedSkins.take( skinName );
+    }
 
-    auto& map = m_data->factoryMap;
+    if ( preloadedSkin )
+    {
+        // waiting for the worker thread, when not being completed yet
+        preloadedSkin->semaphore.acquire();
+
+        auto skin = preloadedSkin->skin;
+        delete preloadedSkin;
 
-    auto name = skinName;
+        if ( skin )
+            return skin;
+    }
+
+    return m_data->createSkin( skinName, QThread::currentThread() );
+}
+
+void QskSkinManager::preloadSkin( const QString& skinName )
+{
+    auto preloadedSkin = new PreloadedSkin();
 
-    auto factory = map.factory( name );
-    if ( factory == nullptr )
     {
-        /*
-            Once the Fusion skin has been implemented it will be used
-            as fallback. For the moment we implement
-            another stupid fallback. TODO ...
-         */
+        QMutexLocker locker( &m_data->mutex );
 
-        const auto names = map.skinNames();
-        if ( !names.isEmpty() )
+        if ( m_data->preloadedSkins.contains( skinName ) )
         {
-            name = names.last();
-            factory = map.factory( name );
+            delete preloadedSkin;
+            return;
         }
+
+        m_data->preloadedSkins.insert( skinName, preloadedSkin );
     }
 
-    return factory ? factory->createSkin( name ) : nullptr;
+    auto d = m_data.get();
+    auto thread = QThread::currentThread();
+
+    QThreadPool::globalInstance()->start( new PreloadRunnable(
+        [ d, skinName, thread ] { return d->createSkin( skinName, thread ); },
+        thread, preloadedSkin ) );
+}
+
+bool QskSkinManager::isPreloaded( const QString& skinName ) const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->preloadedSkins.contains( skinName );
 }
 
 #include "moc_QskSkinManager.cpp"
@@ -40,6 +40,17 @@ public:
 
     QskSkin* createSkin( const QString& skinName ) const;
 
+    /*
+        Loading the plugin and creating the skin might take some time.
+        preloadSkin() does it in a worker thread, so that a following
+        createSkin( skinName ) - f.e. from QskSetup::setSkin() - can
+        return the prebuilt skin without delay.
+     */
+    void preloadSkin( const QString& skinName );
+
+    // true, when the skin has been preloaded or is in progress
+    bool isPreloaded( const QString& skinName ) const;
+
 protected:
     QskSkinManager();
     virtual ~QskSkinManager();
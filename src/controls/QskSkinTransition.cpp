@@ -3,7 +3,8 @@
 #include "QskSkin.h"
 #include "QskSkinHintTable.h"
 #include "QskColorFilter.h"
-#include "QskHintAnimator.h"
+#include "QskVariantAnimator.h"
+#include "QskSetup.h"
 
 #include <QGuiApplication>
 #include <QQuickWindow>
@@ -11,9 +12,12 @@
 #include <QObject>
 #include <QPointer>
 #include <QGlobalStatic>
+#include <QVariantAnimation>
+#include <private/qvariantanimation_p.h>
 
 #include <unordered_map>
 #include <vector>
+#include <memory>
 
 namespace
 {
@@ -54,6 +58,44 @@ namespace
     };
 }
 
+extern void qskUpdateSkinHints( const QVector< QskAspect::Aspect >& );
+
+static void qskUpdateSkinHints( QskSkinTransition::Type mask,
+    const QskSkinHintTable& oldTable,
+    const std::unordered_map< int, QskColorFilter >& oldFilters,
+    const QskSkin* skin )
+{
+    /*
+        Notifying the controls, that depend on hints of the current skin,
+        that have been modified in place. Hints of the types in mask
+        are handled by the animators.
+     */
+
+    if ( skin != qskSetup->skin() )
+        return;
+
+    QVector< QskAspect::Aspect > aspects;
+
+    const auto changedAspects = oldTable.changedAspects( skin->hintTable() );
+    for ( const auto aspect : changedAspects )
+    {
+        const auto type = aspect.type();
+
+        if ( ( ( type == QskAspect::Color ) && ( mask & QskSkinTransition::Color ) ) ||
+            ( ( type == QskAspect::Metric ) && ( mask & QskSkinTransition::Metric ) ) )
+        {
+            continue;
+        }
+
+        aspects += aspect;
+    }
+
+    if ( !( mask & QskSkinTransition::Color ) && ( oldFilters != skin->graphicFilters() ) )
+        aspects += QskAspect::Control | QskAspect::GraphicRole;
+
+    qskUpdateSkinHints( aspects );
+}
+
 static QVector< AnimatorCandidate > qskAnimatorCandidates(
     QskSkinTransition::Type mask,
     const QskSkinHintTable& oldTable,
@@ -160,12 +202,37 @@ static QVector< AnimatorCandidate > qskAnimatorCandidates(
 
 namespace
 {
+    class AnimatorGroup;
+
+    /*
+        All values of a transition share the same duration/easing curve
+        and can be advanced together. So instead of having one animator
+        for each aspect we have one driver for each window, that
+        interpolates all values of the group at once.
+     */
+    class AnimatorDriver final : public QskAnimator
+    {
+    public:
+        AnimatorDriver( AnimatorGroup* group ):
+            m_group( group )
+        {
+        }
+
+    protected:
+        virtual void advance( qreal value ) override;
+
+    private:
+        AnimatorGroup* m_group;
+    };
+
     class AnimatorGroup final : public QObject
     {
         Q_OBJECT
 
     public:
-        AnimatorGroup()
+        AnimatorGroup():
+            m_states( 0 ),
+            m_progress( -1.0 )
         {
         }
 
@@ -174,51 +241,141 @@ namespace
             m_notifyConnection = QskAnimator::addAdvanceHandler( this,
                 SLOT( notify( QQuickWindow* ) ) );
 
-            for ( auto& it : m_hintAnimatorMap )
-                it.second.start();
+            m_values.resize( m_startValues.size() );
 
-            for ( auto& it : m_graphicFilterAnimatorMap )
-                it.second.start();
+            for ( size_t i = 0; i < m_startValues.size(); i++ )
+            {
+                const bool isAnimated = m_interpolators[i] || m_variantInterpolators[i];
+                m_values[i] = isAnimated ? m_startValues[i] : m_endValues[i];
+
+                // detaching once, so that we can interpolate in place later
+                m_values[i].detach();
+            }
+
+            m_progress = -1.0;
+
+            for ( const auto& driver : m_drivers )
+                driver->start();
         }
 
         bool isRunning() const
         {
-            return !m_hintAnimatorMap.empty();
+            for ( const auto& driver : m_drivers )
+            {
+                if ( driver->isRunning() )
+                    return true;
+            }
+
+            return false;
         }
 
         void reset()
         {
             disconnect( m_notifyConnection );
 
-            m_hintAnimatorMap.clear();
-            m_graphicFilterAnimatorMap.clear();
+            m_drivers.clear();
+
+            m_startValues.clear();
+            m_endValues.clear();
+            m_values.clear();
+            m_interpolators.clear();
+            m_variantInterpolators.clear();
+
+            m_hintIndex.clear();
+            m_graphicFilterIndex.clear();
+
+            m_states = 0;
+            m_progress = -1.0;
+
             m_updateInfos.clear();
         }
 
-        inline QVariant animatedHint( QskAspect::Aspect aspect ) const
+        void advance( qreal progress )
         {
-            auto it = m_hintAnimatorMap.find( aspect );
-            if ( it != m_hintAnimatorMap.cend() )
+            /*
+                With more than one window each driver tries to advance
+                the values, but we have to do it only once per tick
+             */
+            if ( qFuzzyCompare( progress, 1.0 ) )
+                progress = 1.0;
+
+            if ( progress == m_progress )
+                return;
+
+            m_progress = progress;
+
+            for ( size_t i = 0; i < m_values.size(); i++ )
             {
-                const auto& animator = it->second;
-                if ( animator.isRunning() )
-                    return animator.currentValue();
+                if ( const auto interpolator = m_interpolators[i] )
+                {
+                    interpolator( m_startValues[i].constData(),
+                        m_endValues[i].constData(), progress, m_values[i].data() );
+                }
+                else if ( const auto variantInterpolator = m_variantInterpolators[i] )
+                {
+                    m_values[i] = variantInterpolator( m_startValues[i].constData(),
+                        m_endValues[i].constData(), progress );
+                }
             }
+        }
+
+        inline const QVariant* animatedHint( QskAspect::Aspect aspect ) const
+        {
+            const auto it = m_hintIndex.find( aspect );
+            if ( it != m_hintIndex.cend() )
+                return &m_values[ it->second ];
 
-            return QVariant();
+            return nullptr;
         }
 
-        inline QVariant animatedGraphicFilter( int graphicRole ) const
+        const QVariant* resolvedHint( QskAspect::Aspect aspect,
+            QskAspect::Aspect* resolvedAspect ) const
         {
-            auto it = m_graphicFilterAnimatorMap.find( graphicRole );
-            if ( it != m_graphicFilterAnimatorMap.cend() )
+            if ( m_hintIndex.empty() )
+                return nullptr;
+
+            /*
+                The lookups are done by stripping the state bits one by one.
+                As long as the aspect has state bits, that are not used by
+                any of the animated aspects, a lookup can't be successful
+                and we can jump below the highest of them.
+             */
+
+            const quint32 unusedStates = aspect.state() & ~m_states;
+            if ( unusedStates )
             {
-                const auto& animator = it->second;
-                if ( animator.isRunning() )
-                    return animator.currentValue();
+                const quint32 highestState =
+                    1u << ( 31 - qCountLeadingZeroBits( unusedStates ) );
+
+                aspect.clearState( static_cast< QskAspect::State >(
+                    ~( highestState - 1 ) & QskAspect::AllStates ) );
             }
 
-            return QVariant();
+            Q_FOREVER
+            {
+                if ( const auto value = animatedHint( aspect ) )
+                {
+                    if ( resolvedAspect )
+                        *resolvedAspect = aspect;
+
+                    return value;
+                }
+
+                const auto topState = aspect.topState();
+                if ( topState == QskAspect::NoState )
+                    return nullptr;
+
+                aspect.clearState( topState );
+            }
+        }
+
+        inline const QVariant* animatedGraphicFilter( int graphicRole ) const
+        {
+            const auto it = m_graphicFilterIndex.find( graphicRole );
+            if ( it != m_graphicFilterIndex.cend() )
+                return &m_values[ it->second ];
+
+            return nullptr;
         }
 
         void addGraphicFilterAnimators(
@@ -239,14 +396,13 @@ namespace
 
                 if ( f1 != f2 )
                 {
-                    QskVariantAnimator animator;
-                    animator.setWindow( window );
-                    animator.setDuration( animatorHint.duration );
-                    animator.setEasingCurve( animatorHint.type );
-                    animator.setStartValue( QVariant::fromValue( f1 ) );
-                    animator.setEndValue( QVariant::fromValue( f2 ) );
-
-                    m_graphicFilterAnimatorMap.emplace( it2->first, animator );
+                    if ( m_graphicFilterIndex.find( it2->first ) == m_graphicFilterIndex.end() )
+                    {
+                        m_graphicFilterIndex.emplace( it2->first,
+                            addValue( QVariant::fromValue( f1 ), QVariant::fromValue( f2 ) ) );
+                    }
+
+                    addDriver( window, animatorHint );
                 }
             }
         }
@@ -269,7 +425,7 @@ namespace
                         graphic filters we schedule an initial update and let the
                         controls do the rest: see QskSkinnable::effectiveGraphicFilter
                      */
-                    control->update();
+                    control->updateNodeRoles( ~quint64( 0 ) );
 #endif
                 }
             }
@@ -297,15 +453,12 @@ namespace
                     }
 
                     if ( info.updateModes & UpdateInfo::Update )
-                        control->update();
+                        control->updateNodeRoles( ~quint64( 0 ) );
                 }
             }
 
-            if ( !m_hintAnimatorMap.empty() )
-            {
-                if ( !m_hintAnimatorMap.begin()->second.isRunning() )
-                    reset();
-            }
+            if ( !isRunning() )
+                reset();
         }
 
     private:
@@ -379,22 +532,63 @@ namespace
         void addAnimator( QQuickWindow* window,
             const AnimatorCandidate& candidate, QskAnimationHint animationHint )
         {
-            auto it = m_hintAnimatorMap.find( candidate.aspect );
-            if ( it != m_hintAnimatorMap.end() )
+            addDriver( window, animationHint );
+
+            if ( m_hintIndex.find( candidate.aspect ) != m_hintIndex.end() )
                 return; // already there
 
-            it = m_hintAnimatorMap.emplace( candidate.aspect, QskHintAnimator() ).first;
-            auto& animator = it->second;
+            m_hintIndex.emplace( candidate.aspect,
+                addValue( candidate.from, candidate.to ) );
+
+            m_states |= candidate.aspect.state();
+        }
+
+        int addValue( const QVariant& from, const QVariant& to )
+        {
+            QskVariantAnimator::Interpolator interpolator = nullptr;
+            QVariantAnimation::Interpolator variantInterpolator = nullptr;
 
-            animator.setAspect( candidate.aspect );
-            animator.setStartValue( candidate.from );
-            animator.setEndValue( candidate.to );
+            if ( from.userType() == to.userType() )
+            {
+                /*
+                    All types, that are usually found for color
+                    and metric hints have an interpolator, that updates
+                    the value in place. For all others we fall back
+                    to what has been registered by qRegisterAnimationInterpolator
+                    like QskVariantAnimator does. Values without any
+                    interpolator are set to their final value immediately.
+                 */
+                interpolator = QskVariantAnimator::interpolator( from.userType() );
+
+                if ( interpolator == nullptr )
+                {
+                    variantInterpolator =
+                        QVariantAnimationPrivate::getInterpolator( from.userType() );
+                }
+            }
+
+            m_startValues.push_back( from );
+            m_endValues.push_back( to );
+            m_interpolators.push_back( interpolator );
+            m_variantInterpolators.push_back( variantInterpolator );
+
+            return static_cast< int >( m_startValues.size() - 1 );
+        }
+
+        void addDriver( QQuickWindow* window, QskAnimationHint animationHint )
+        {
+            for ( const auto& driver : m_drivers )
+            {
+                if ( driver->window() == window )
+                    return;
+            }
 
-            animator.setDuration( animationHint.duration );
-            animator.setEasingCurve( animationHint.type );
+            auto driver = new AnimatorDriver( this );
+            driver->setWindow( window );
+            driver->setDuration( animationHint.duration );
+            driver->setEasingCurve( animationHint.type );
 
-            animator.setControl( nullptr );
-            animator.setWindow( window );
+            m_drivers.push_back( std::unique_ptr< AnimatorDriver >( driver ) );
         }
 
         inline void storeUpdateInfo( QskControl* control, QskAspect::Aspect aspect )
@@ -415,12 +609,32 @@ namespace
                 m_updateInfos.insert( it, info );
         }
 
-        std::unordered_map< QskAspect::Aspect, QskHintAnimator > m_hintAnimatorMap;
-        std::unordered_map< int, QskVariantAnimator > m_graphicFilterAnimatorMap;
+        // the values as structure of arrays: good for advancing them all at once
+        std::vector< QVariant > m_startValues;
+        std::vector< QVariant > m_endValues;
+        std::vector< QVariant > m_values;
+        std::vector< QskVariantAnimator::Interpolator > m_interpolators;
+        std::vector< QVariantAnimation::Interpolator > m_variantInterpolators;
+
+        // the positions of the values in the arrays above
+        std::unordered_map< QskAspect::Aspect, int > m_hintIndex;
+        std::unordered_map< int, int > m_graphicFilterIndex;
+
+        // all state bits, that are used by the aspects of m_hintIndex
+        quint16 m_states;
+
+        qreal m_progress;
+
+        std::vector< std::unique_ptr< AnimatorDriver > > m_drivers; // one for each window
         std::vector< UpdateInfo > m_updateInfos; // vector: for fast iteration
 
         QMetaObject::Connection m_notifyConnection;
     };
+
+    void AnimatorDriver::advance( qreal value )
+    {
+        m_group->advance( value );
+    }
 }
 
 Q_GLOBAL_STATIC( AnimatorGroup, qskSkinAnimator )
@@ -493,7 +707,15 @@ void QskSkinTransition::process()
     if ( ( m_animationHint.duration <= 0 ) || ( m_mask == 0 ) )
     {
         // no animations, we can apply the changes
+
+        const auto oldTable = m_skins[1]->hintTable();
+        const auto oldFilters = m_skins[1]->graphicFilters();
+
         updateSkin( m_skins[0], m_skins[1] );
+
+        qskUpdateSkinHints( static_cast< Type >( 0 ),
+            oldTable, oldFilters, m_skins[1] );
+
         return;
     }
 
@@ -506,8 +728,23 @@ void QskSkinTransition::process()
 
         const auto oldTable = m_skins[0]->hintTable();
 
-        // apply the changes
-        updateSkin( m_skins[0], m_skins[1] );
+        if ( m_skins[0] == m_skins[1] )
+        {
+            // apply the changes
+            updateSkin( m_skins[0], m_skins[1] );
+
+            qskUpdateSkinHints( m_mask, oldTable, oldFilters, m_skins[1] );
+        }
+        else
+        {
+            const auto targetTable = m_skins[1]->hintTable();
+            const auto targetFilters = m_skins[1]->graphicFilters();
+
+            // apply the changes
+            updateSkin( m_skins[0], m_skins[1] );
+
+            qskUpdateSkinHints( m_mask, targetTable, targetFilters, m_skins[1] );
+        }
 
         candidates = qskAnimatorCandidates( m_mask, oldTable, oldFilters,
             m_skins[1]->hintTable(), m_skins[1]->graphicFilters() );
@@ -552,18 +789,33 @@ bool QskSkinTransition::isRunning()
 
 QVariant QskSkinTransition::animatedHint( QskAspect::Aspect aspect )
 {
-    if ( !qskSkinAnimator.exists() )
-        return QVariant();
+    if ( isRunning() )
+    {
+        if ( auto value = qskSkinAnimator->animatedHint( aspect ) )
+            return *value;
+    }
+
+    return QVariant();
+}
+
+const QVariant* QskSkinTransition::resolvedHint(
+    QskAspect::Aspect aspect, QskAspect::Aspect* resolvedAspect )
+{
+    if ( isRunning() )
+        return qskSkinAnimator->resolvedHint( aspect, resolvedAspect );
 
-    return qskSkinAnimator->animatedHint( aspect );
+    return nullptr;
 }
 
 QVariant QskSkinTransition::animatedGraphicFilter( int graphicRole )
 {
-    if ( !qskSkinAnimator.exists() )
-        return QVariant();
+    if ( isRunning() )
+    {
+        if ( auto value = qskSkinAnimator->animatedGraphicFilter( graphicRole ) )
+            return *value;
+    }
 
-    return qskSkinAnimator->animatedGraphicFilter( graphicRole );
+    return QVariant();
 }
 
 #include "QskSkinTransition.moc"
@@ -39,6 +39,10 @@ public:
 
     static bool isRunning();
     static QVariant animatedHint( QskAspect::Aspect );
+
+    static const QVariant* resolvedHint( QskAspect::Aspect,
+        QskAspect::Aspect* resolvedAspect = nullptr );
+
     static QVariant animatedGraphicFilter( int graphicRole );
 
 protected:
@@ -21,6 +21,7 @@
 #include "QskGraphicNode.h"
 #include "QskGraphicTextureFactory.h"
 #include "QskFunctions.h"
+#include "QskFrameProfiler.h"
 
 #include <QSGSimpleRectNode>
 
@@ -169,6 +170,11 @@ const QVector< quint8 >& QskSkinlet::nodeRoles() const
     return m_data->nodeRoles;
 }
 
+quint64 QskSkinlet::nodeRoleMask( QskAspect::Aspect ) const
+{
+    return ~quint64( 0 );
+}
+
 void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) const
 {
     QSGNode* oldNode;
@@ -197,12 +203,24 @@ void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) cons
         insertRemoveNodes( parentNode, oldNode, newNode, qskDebugRole );
     }
 
+    /*
+        Controls might request updates for specific roles only,
+        see QskSkinnable::updateNodeRoles. Without any child nodes
+        we are initially painting and have to create all nodes.
+     */
+    quint64 dirtyRoles = skinnable->dirtyNodeRoles();
+    if ( parentNode->firstChild() == nullptr )
+        dirtyRoles = ~quint64( 0 );
+
     for ( int i = 0; i < m_data->nodeRoles.size(); i++ )
     {
         const auto nodeRole = m_data->nodeRoles[i];
 
         Q_ASSERT( nodeRole <= 245 ); // reserving 10 roles
 
+        if ( ( nodeRole < 64 ) && !( dirtyRoles & ( quint64( 1 ) << nodeRole ) ) )
+            continue;
+
         oldNode = qskFindNodeByFlag( parentNode, nodeRole );
         newNode = updateSubNode( skinnable, nodeRole, oldNode );
 
@@ -273,6 +291,9 @@ void QskSkinlet::insertRemoveNodes( QSGNode* parentNode,
 {
     if ( newNode && newNode->parent() != parentNode )
     {
+        if ( QskFrameProfiler::isActive() && newNode->parent() == nullptr )
+            QskFrameProfiler::countNodes( 1, 0 );
+
         qskSetRole( nodeRole, newNode );
 
         switch( nodeRole )
@@ -304,7 +325,12 @@ void QskSkinlet::insertRemoveNodes( QSGNode* parentNode,
     {
         parentNode->removeChildNode( oldNode );
         if ( oldNode->flags() & QSGNode::OwnedByParent )
+        {
+            if ( QskFrameProfiler::isActive() )
+                QskFrameProfiler::countNodes( 0, 1 );
+
             delete oldNode;
+        }
     }
 }
 
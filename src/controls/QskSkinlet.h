@@ -42,6 +42,12 @@ public:
 
     const QVector< quint8 >& nodeRoles() const;
 
+    /*
+        Bits of the node roles, that depend on a hint - usually the roles
+        of its subcontrol. The default implementation returns all roles.
+     */
+    virtual quint64 nodeRoleMask( QskAspect::Aspect ) const;
+
     void setOwnedBySkinnable( bool on );
     bool isOwnedBySkinnable() const;
 
@@ -20,6 +20,10 @@
 #include <QFont>
 #include <QElapsedTimer>
 #include <QMarginsF>
+#include <QPointer>
+
+#include <algorithm>
+#include <vector>
 
 #define DEBUG_MAP 0
 #define DEBUG_ANIMATOR 0
@@ -41,6 +45,42 @@ static inline bool qskIsControl( const QskSkinnable* skinnable )
 #endif
 }
 
+static inline QskAspect::Aspect qskDependencyAspect( QskAspect::Aspect aspect )
+{
+    // the skin hints of all states/placements are considered as one dependency
+
+    aspect.clearStates();
+    aspect.setPlacement( QskAspect::Preserved );
+
+    return aspect;
+}
+
+static inline bool qskIsDependent(
+    const std::vector< QskAspect::Aspect >& dependencies, QskAspect::Aspect aspect )
+{
+    aspect = qskDependencyAspect( aspect );
+
+    if ( std::binary_search( dependencies.cbegin(), dependencies.cend(), aspect ) )
+        return true;
+
+    if ( aspect.subControl() == QskAspect::Control )
+    {
+        // hints for QskAspect::Control are the fallback for all subcontrols
+
+        for ( const auto dependency : dependencies )
+        {
+            if ( dependency.type() == aspect.type()
+                && dependency.primitive() == aspect.primitive()
+                && dependency.isAnimator() == aspect.isAnimator() )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 static inline bool qskCompareResolvedStates(
     QskAspect::Aspect& aspect1, QskAspect::Aspect& aspect2,
     const QskSkinHintTable& table )
@@ -108,7 +148,9 @@ public:
     PrivateData():
         skinlet( nullptr ),
         skinState( QskAspect::NoState ),
-        hasLocalSkinlet( false )
+        dirtyNodeRoles( 0 ),
+        hasLocalSkinlet( false ),
+        restrictedNodeRoles( false )
     {
     }
 
@@ -125,11 +167,80 @@ public:
     QskHintAnimatorTable animators;
 
     const QskSkinlet* skinlet;
+    QPointer< QskSkin > skin; // the skin of a non local skinlet
+
+    /*
+        The skin hints, that have been looked up so far. They are used
+        to find out if a control is affected by changes of the skin.
+     */
+    std::vector< QskAspect::Aspect > skinHintDependencies;
 
     QskAspect::State skinState;
+
+    /*
+        bits of the node roles, that have to be updated, see QskSkinlet::updateNode.
+        They are only respected, when updateNodeRoles has been called since the
+        last update of the nodes - otherwise all roles are updated.
+     */
+    quint64 dirtyNodeRoles;
+
     bool hasLocalSkinlet : 1;
+    bool restrictedNodeRoles : 1;
 };
 
+template< typename T >
+static inline T qskHintValue( const QVariant& hint )
+{
+    return hint.value< T >();
+}
+
+template<>
+inline QVariant qskHintValue< QVariant >( const QVariant& hint )
+{
+    return hint;
+}
+
+template<>
+inline int qskHintValue< int >( const QVariant& hint )
+{
+    return hint.toInt();
+}
+
+template<>
+inline qreal qskHintValue< qreal >( const QVariant& hint )
+{
+    return hint.toReal();
+}
+
+template< typename T >
+inline T QskSkinnable::effectiveHintValue(
+    QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
+{
+    /*
+        The typed accessors convert from the stored hint directly,
+        instead of creating a temporary copy of the QVariant. Looking
+        for animated values is skipped, when no animator is running.
+     */
+
+    aspect.setSubControl( effectiveSubcontrol( aspect.subControl() ) );
+    aspect.setPlacement( effectivePlacement() );
+
+    if ( aspect.isAnimator() )
+        return qskHintValue< T >( storedHint( aspect, status ) );
+
+    if ( !m_data->animators.isEmpty() || QskSkinTransition::isRunning() )
+    {
+        const QVariant v = animatedValue( aspect, status );
+        if ( v.isValid() )
+            return qskHintValue< T >( v );
+    }
+
+    if ( aspect.state() == QskAspect::NoState )
+        aspect = aspect | skinState();
+
+    return qskHintValue< T >( storedHint( aspect, status ) );
+}
+
 QskSkinnable::QskSkinnable():
     m_data( new PrivateData() )
 {
@@ -151,13 +262,17 @@ void QskSkinnable::setSkinlet( const QskSkinlet* skinlet )
         return;
     }
 
-    if ( m_data->skinlet && m_data->skinlet->isOwnedBySkinnable() )
-        delete m_data->skinlet;
+    if ( m_data->hasLocalSkinlet )
+    {
+        // a non local skinlet might already be gone with its skin
+        if ( m_data->skinlet && m_data->skinlet->isOwnedBySkinnable() )
+            delete m_data->skinlet;
+    }
 
     m_data->skinlet = skinlet;
     m_data->hasLocalSkinlet = ( skinlet != nullptr );
 
-    owningControl()->update();
+    updateNodeRoles( ~quint64( 0 ) );
 }
 
 const QskSkinlet* QskSkinnable::skinlet() const
@@ -167,15 +282,41 @@ const QskSkinlet* QskSkinnable::skinlet() const
 
 const QskSkinlet* QskSkinnable::effectiveSkinlet() const
 {
-    if ( m_data->skinlet == nullptr )
+    if ( !m_data->hasLocalSkinlet )
     {
-        m_data->skinlet = qskSetup->skin()->skinlet( this );
-        m_data->hasLocalSkinlet = false;
+        /*
+            Skinlets of the same class can be exchanged without
+            notifying the control, so we check for the current skin
+            each time.
+         */
+        auto skin = qskSetup->skin();
+
+        if ( m_data->skinlet == nullptr || m_data->skin != skin )
+        {
+            m_data->skinlet = skin->skinlet( this );
+            m_data->skin = skin;
+        }
     }
 
     return m_data->skinlet;
 }
 
+bool QskSkinnable::dependsOnSkinHints(
+    const QVector< QskAspect::Aspect >& aspects ) const
+{
+    const auto& dependencies = m_data->skinHintDependencies;
+    if ( dependencies.empty() )
+        return false;
+
+    for ( const auto aspect : aspects )
+    {
+        if ( qskIsDependent( dependencies, aspect ) )
+            return true;
+    }
+
+    return false;
+}
+
 QskSkinHintTable& QskSkinnable::hintTable()
 {
     return m_data->hintTable;
@@ -186,6 +327,21 @@ const QskSkinHintTable& QskSkinnable::hintTable() const
     return m_data->hintTable;
 }
 
+void QskSkinnable::setHintTable( const QskSkinHintTable& table )
+{
+    if ( table.isSharedWith( m_data->hintTable ) )
+        return;
+
+    m_data->hintTable = table;
+
+    if ( auto control = owningControl() )
+    {
+        control->resetImplicitSize();
+        control->polish();
+        control->updateNodeRoles( ~quint64( 0 ) );
+    }
+}
+
 void QskSkinnable::setFlagHint( QskAspect::Aspect aspect, int flag )
 {
     m_data->hintTable.setHint( aspect, QVariant( flag ) );
@@ -193,7 +349,7 @@ void QskSkinnable::setFlagHint( QskAspect::Aspect aspect, int flag )
 
 int QskSkinnable::flagHint( QskAspect::Aspect aspect ) const
 {
-    return effectiveHint( aspect ).toInt();
+    return effectiveHintValue< int >( aspect );
 }
 
 void QskSkinnable::setColor( QskAspect::Aspect aspect, const QColor& color )
@@ -213,7 +369,7 @@ void QskSkinnable::setColor( QskAspect::Aspect aspect, QRgb rgb )
 
 QColor QskSkinnable::color( QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveHint( aspect | QskAspect::Color, status ).value< QColor >();
+    return effectiveHintValue< QColor >( aspect | QskAspect::Color, status );
 }
 
 void QskSkinnable::setMetric( QskAspect::Aspect aspect, qreal metric )
@@ -223,7 +379,7 @@ void QskSkinnable::setMetric( QskAspect::Aspect aspect, qreal metric )
 
 qreal QskSkinnable::metric( QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveHint( aspect | QskAspect::Metric, status ).toReal();
+    return effectiveHintValue< qreal >( aspect | QskAspect::Metric, status );
 }
 
 void QskSkinnable::setMarginsHint( QskAspect::Aspect aspect, qreal margins )
@@ -239,7 +395,7 @@ void QskSkinnable::setMarginsHint( QskAspect::Aspect aspect, const QMarginsF& ma
 QMarginsF QskSkinnable::marginsHint(
     QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveHint( aspect | QskAspect::Metric, status ).value< QskMargins >();
+    return effectiveHintValue< QskMargins >( aspect | QskAspect::Metric, status );
 }
 
 void QskSkinnable::setGradientHint(
@@ -251,7 +407,7 @@ void QskSkinnable::setGradientHint(
 QskGradient QskSkinnable::gradientHint(
     QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveHint( aspect | QskAspect::Color, status ).value< QskGradient >();
+    return effectiveHintValue< QskGradient >( aspect | QskAspect::Color, status );
 }
 
 void QskSkinnable::setBoxShapeHint(
@@ -264,7 +420,7 @@ QskBoxShapeMetrics QskSkinnable::boxShapeHint(
     QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
     using namespace QskAspect;
-    return effectiveHint( aspect | Metric | Shape, status ).value< QskBoxShapeMetrics >();
+    return effectiveHintValue< QskBoxShapeMetrics >( aspect | Metric | Shape, status );
 }
 
 void QskSkinnable::setBoxBorderMetricsHint(
@@ -277,7 +433,7 @@ QskBoxBorderMetrics QskSkinnable::boxBorderMetricsHint(
     QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
     using namespace QskAspect;
-    return effectiveHint( aspect | Metric | Border, status ).value< QskBoxBorderMetrics >();
+    return effectiveHintValue< QskBoxBorderMetrics >( aspect | Metric | Border, status );
 }
 
 void QskSkinnable::setBoxBorderColorsHint(
@@ -290,7 +446,7 @@ QskBoxBorderColors QskSkinnable::boxBorderColorsHint(
     QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
     using namespace QskAspect;
-    return effectiveHint( aspect | Color | Border, status ).value< QskBoxBorderColors >();
+    return effectiveHintValue< QskBoxBorderColors >( aspect | Color | Border, status );
 }
 
 void QskSkinnable::setFontRole( QskAspect::Aspect aspect, int role )
@@ -300,7 +456,7 @@ void QskSkinnable::setFontRole( QskAspect::Aspect aspect, int role )
 
 int QskSkinnable::fontRole( QskAspect::Aspect aspect ) const
 {
-    return effectiveHint( aspect | QskAspect::FontRole ).toInt();
+    return effectiveHintValue< int >( aspect | QskAspect::FontRole );
 }
 
 QFont QskSkinnable::effectiveFont( QskAspect::Aspect aspect ) const
@@ -315,7 +471,7 @@ void QskSkinnable::setGraphicRole( QskAspect::Aspect aspect, int role )
 
 int QskSkinnable::graphicRole( QskAspect::Aspect aspect ) const
 {
-    return effectiveHint( aspect | QskAspect::GraphicRole ).toInt();
+    return effectiveHintValue< int >( aspect | QskAspect::GraphicRole );
 }
 
 QskColorFilter QskSkinnable::effectiveGraphicFilter(
@@ -355,7 +511,7 @@ QskColorFilter QskSkinnable::effectiveGraphicFilter(
                         on the animated graphic filters we reschedule
                         our updates here.
                      */
-                    owningControl()->update();
+                    owningControl()->updateNodeRoles( ~quint64( 0 ) );
                 }
 
                 return v.value< QskColorFilter >();
@@ -376,7 +532,7 @@ QskAnimationHint QskSkinnable::animation(
     QskAspect::Aspect aspect, QskSkinHintStatus* status  ) const
 {
     aspect.setAnimator( true );
-    return effectiveHint( aspect, status ).value< QskAnimationHint >();
+    return effectiveHintValue< QskAnimationHint >( aspect, status );
 }
 
 QskAnimationHint QskSkinnable::effectiveAnimation(
@@ -428,20 +584,7 @@ QskAnimationHint QskSkinnable::effectiveAnimation(
 QVariant QskSkinnable::effectiveHint(
     QskAspect::Aspect aspect, QskSkinHintStatus* status ) const
 {
-    aspect.setSubControl( effectiveSubcontrol( aspect.subControl() ) );
-    aspect.setPlacement( effectivePlacement() );
-
-    if ( aspect.isAnimator() )
-        return storedHint( aspect, status );
-
-    const QVariant v = animatedValue( aspect, status );
-    if ( v.isValid() )
-        return v;
-
-    if ( aspect.state() == QskAspect::NoState )
-        aspect = aspect | skinState();
-
-    return storedHint( aspect, status );
+    return effectiveHintValue< QVariant >( aspect, status );
 }
 
 QskSkinHintStatus QskSkinnable::hintStatus( QskAspect::Aspect aspect ) const
@@ -483,14 +626,8 @@ QVariant QskSkinnable::animatedValue(
             if ( aspect.state() == QskAspect::NoState )
                 aspect = aspect | skinState();
 
-            Q_FOREVER
-            {
-                v = QskSkinTransition::animatedHint( aspect );
-                if ( v.isValid() || aspect.state() == QskAspect::NoState )
-                    break;
-
-                aspect.clearState( aspect.topState() );
-            }
+            if ( auto value = QskSkinTransition::resolvedHint( aspect, &aspect ) )
+                v = *value;
         }
     }
 
@@ -532,6 +669,16 @@ const QVariant& QskSkinnable::storedHint(
 
     // next we try the hints from the skin
 
+    {
+        auto& dependencies = m_data->skinHintDependencies;
+
+        const auto dependency = qskDependencyAspect( aspect );
+
+        auto it = std::lower_bound( dependencies.begin(), dependencies.end(), dependency );
+        if ( it == dependencies.end() || *it != dependency )
+            dependencies.insert( it, dependency );
+    }
+
     const auto& skinTable = effectiveSkin()->hintTable();
     if ( skinTable.hasHints() )
     {
@@ -815,7 +962,7 @@ void QskSkinnable::setSkinStateFlag( QskAspect::State state, bool on )
     }
 
     m_data->skinState = newState;
-    control->update();
+    control->updateNodeRoles( ~quint64( 0 ) );
 }
 
 QskSkin* QskSkinnable::effectiveSkin() const
@@ -827,6 +974,29 @@ QskSkin* QskSkinnable::effectiveSkin() const
 void QskSkinnable::updateNode( QSGNode* parentNode )
 {
     effectiveSkinlet()->updateNode( this, parentNode );
+
+    m_data->dirtyNodeRoles = 0;
+    m_data->restrictedNodeRoles = false;
+}
+
+void QskSkinnable::updateNodeRoles( quint64 nodeRoleMask )
+{
+    m_data->dirtyNodeRoles |= nodeRoleMask;
+    m_data->restrictedNodeRoles = true;
+
+    owningControl()->update();
+}
+
+quint64 QskSkinnable::dirtyNodeRoles() const
+{
+    /*
+        Updates, that have not been requested by updateNodeRoles -
+        f.e. QQuickItem::update() or resizing - affect all roles
+     */
+    if ( !m_data->restrictedNodeRoles )
+        return ~quint64( 0 );
+
+    return m_data->dirtyNodeRoles;
 }
 
 QskAspect::Subcontrol QskSkinnable::effectiveSubcontrol(
@@ -10,6 +10,7 @@
 #include "QskAspect.h"
 
 #include <QVariant>
+#include <QVector>
 #include <memory>
 
 typedef unsigned int QRgb;
@@ -120,12 +121,32 @@ public:
     QVariant effectiveHint( QskAspect::Aspect, QskSkinHintStatus* = nullptr ) const;
     virtual QskAspect::Placement effectivePlacement() const;
 
+    /*
+        Replacing all local hints. The table is shared until one of
+        the skinnables modifies its hints, so that many controls with
+        the same style ( f.e. a "danger" button ) have only one copy.
+     */
+    void setHintTable( const QskSkinHintTable& );
+
     QskSkinHintStatus hintStatus( QskAspect::Aspect ) const;
 
     QskAspect::State skinState() const;
     const char* skinStateAsPrintable() const;
     const char* skinStateAsPrintable( QskAspect::State ) const;
 
+    /*
+        Bits of the node roles, that need to be updated.
+        Roles >= 64 are always updated.
+     */
+    quint64 dirtyNodeRoles() const;
+
+    /*
+        Updating the nodes of the given roles only. Other roles are
+        skipped until the next update of the nodes - even when
+        QQuickItem::update() has been called in between.
+     */
+    void updateNodeRoles( quint64 nodeRoleMask );
+
     QSizeF outerBoxSize( QskAspect::Aspect, const QSizeF& innerBoxSize ) const;
     QSizeF innerBoxSize( QskAspect::Aspect, const QSizeF& outerBoxSize ) const;
 
@@ -137,6 +158,8 @@ public:
     virtual const QskSkinlet* effectiveSkinlet() const;
     QskSkin* effectiveSkin() const;
 
+    bool dependsOnSkinHints( const QVector< QskAspect::Aspect >& ) const;
+
     void startTransition( QskAspect::Aspect,
         QskAnimationHint, QVariant from, QVariant to );
 
@@ -161,6 +184,9 @@ protected:
     const QskSkinHintTable &hintTable() const;
 
 private:
+    template< typename T >
+    T effectiveHintValue( QskAspect::Aspect, QskSkinHintStatus* = nullptr ) const;
+
     QVariant animatedValue( QskAspect::Aspect, QskSkinHintStatus* ) const;
     const QVariant& storedHint( QskAspect::Aspect, QskSkinHintStatus* = nullptr ) const;
 
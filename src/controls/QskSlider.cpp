@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskSlider.h"
+#include "QskSliderSkinlet.h"
 #include "QskAspect.h"
 #include "QskAnimationHint.h"
 
@@ -80,7 +81,7 @@ void QskSlider::setOrientation( Qt::Orientation orientation )
         setSizePolicy( sizePolicy( Qt::Vertical ), sizePolicy( Qt::Horizontal ) );
 #endif
         resetImplicitSize();
-        update();
+        updateNodeRoles( ~quint64( 0 ) );
 
         Q_EMIT orientationChanged( m_data->orientation );
     }
@@ -243,7 +244,7 @@ void QskSlider::updatePosition()
         setMetric( aspect, pos );
     }
 
-    update();
+    updateNodeRoles( effectiveSkinlet()->nodeRoleMask( aspect ) );
 }
 
 #include "moc_QskSlider.cpp"
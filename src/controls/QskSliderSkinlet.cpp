@@ -57,6 +57,38 @@ QRectF QskSliderSkinlet::subControlRect(
     return Inherited::subControlRect( skinnable, subControl );
 }
 
+quint64 QskSliderSkinlet::nodeRoleMask( QskAspect::Aspect aspect ) const
+{
+    const auto subControl = aspect.subControl();
+
+    if ( aspect.type() == QskAspect::Metric )
+    {
+        if ( subControl == QskSlider::Handle
+            && aspect.metricPrimitive() == QskAspect::Position )
+        {
+            // the groove and the panel don't depend on the position
+            return ( quint64( 1 ) << FillRole ) | ( quint64( 1 ) << HandleRole );
+        }
+
+        // other metrics might change the geometries of all subcontrols
+        return Inherited::nodeRoleMask( aspect );
+    }
+
+    if ( subControl == QskSlider::Panel )
+        return quint64( 1 ) << PanelRole;
+
+    if ( subControl == QskSlider::Groove )
+        return quint64( 1 ) << GrooveRole;
+
+    if ( subControl == QskSlider::Fill )
+        return quint64( 1 ) << FillRole;
+
+    if ( subControl == QskSlider::Handle )
+        return quint64( 1 ) << HandleRole;
+
+    return Inherited::nodeRoleMask( aspect );
+}
+
 QSGNode* QskSliderSkinlet::updateSubNode(
     const QskSkinnable* skinnable, quint8 nodeRole, QSGNode* node ) const
 {
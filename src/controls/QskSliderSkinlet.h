@@ -32,6 +32,8 @@ public:
     virtual QRectF subControlRect( const QskSkinnable*,
         QskAspect::Subcontrol ) const override;
 
+    virtual quint64 nodeRoleMask( QskAspect::Aspect ) const override;
+
 protected:
     virtual QSGNode* updateSubNode( const QskSkinnable*,
         quint8 nodeRole, QSGNode* ) const override;
@@ -11,6 +11,7 @@
 #include "QskBoxBorderColors.h"
 #include "QskGradient.h"
 #include "QskTextColors.h"
+#include "QskRgbValue.h"
 
 // Even if we don't use the standard Qt animation system we
 // use its registry of interpolators: why adding our own ...
@@ -57,8 +58,59 @@ QSK_DECL_INSANE static inline QVariant qskInterpolate (
     return f( from.constData(), to.constData(), progress );
 }
 
+namespace
+{
+    /*
+        For the types, that are animated all the time we avoid
+        the QVariantAnimation interpolators, that return a new QVariant
+        for each step. Instead the value is interpolated into the
+        detached storage of m_currentValue, so that running animators
+        do not allocate or convert anything per frame.
+     */
+
+    template< typename T >
+    inline bool qskAssignValue( void* value, const T& newValue )
+    {
+        auto& v = *static_cast< T* >( value );
+        if ( v == newValue )
+            return false;
+
+        v = newValue;
+        return true;
+    }
+
+    template< typename T >
+    bool qskInterpolateTyped( const void* from,
+        const void* to, qreal progress, void* value )
+    {
+        const auto& v1 = *static_cast< const T* >( from );
+        const auto& v2 = *static_cast< const T* >( to );
+
+        return qskAssignValue( value, v1.interpolated( v2, progress ) );
+    }
+
+    bool qskInterpolateReal( const void* from,
+        const void* to, qreal progress, void* value )
+    {
+        const auto v1 = *static_cast< const qreal* >( from );
+        const auto v2 = *static_cast< const qreal* >( to );
+
+        return qskAssignValue( value, v1 + ( v2 - v1 ) * progress );
+    }
+
+    bool qskInterpolateColor( const void* from,
+        const void* to, qreal progress, void* value )
+    {
+        const auto& c1 = *static_cast< const QColor* >( from );
+        const auto& c2 = *static_cast< const QColor* >( to );
+
+        return qskAssignValue( value, QskRgbValue::interpolated( c1, c2, progress ) );
+    }
+}
+
 QskVariantAnimator::QskVariantAnimator():
-    m_interpolator( nullptr )
+    m_interpolator( nullptr ),
+    m_typedInterpolator( nullptr )
 {
 }
 
@@ -66,6 +118,41 @@ QskVariantAnimator::~QskVariantAnimator()
 {
 }
 
+QskVariantAnimator::Interpolator QskVariantAnimator::interpolator( int userType )
+{
+    switch( userType )
+    {
+        case QMetaType::QReal:
+            return qskInterpolateReal;
+
+        case QMetaType::QColor:
+            return qskInterpolateColor;
+    }
+
+    if ( userType == qMetaTypeId< QskMargins >() )
+        return qskInterpolateTyped< QskMargins >;
+
+    if ( userType == qMetaTypeId< QskBoxShapeMetrics >() )
+        return qskInterpolateTyped< QskBoxShapeMetrics >;
+
+    if ( userType == qMetaTypeId< QskBoxBorderMetrics >() )
+        return qskInterpolateTyped< QskBoxBorderMetrics >;
+
+    if ( userType == qMetaTypeId< QskBoxBorderColors >() )
+        return qskInterpolateTyped< QskBoxBorderColors >;
+
+    if ( userType == qMetaTypeId< QskTextColors >() )
+        return qskInterpolateTyped< QskTextColors >;
+
+    if ( userType == qMetaTypeId< QskGradient >() )
+        return qskInterpolateTyped< QskGradient >;
+
+    if ( userType == qMetaTypeId< QskColorFilter >() )
+        return qskInterpolateTyped< QskColorFilter >;
+
+    return nullptr;
+}
+
 void QskVariantAnimator::setStartValue( const QVariant& value )
 {
     m_startValue = value;
@@ -84,30 +171,71 @@ void QskVariantAnimator::setCurrentValue( const QVariant& value )
 void QskVariantAnimator::setup()
 {
     m_interpolator = nullptr;
+    m_typedInterpolator = nullptr;
 
     const auto type = m_startValue.userType();
     if ( type == m_endValue.userType() )
     {
-        // all what has been registered by qRegisterAnimationInterpolator
-        m_interpolator = reinterpret_cast< void (*)() >( QVariantAnimationPrivate::getInterpolator( type ) );
+        m_typedInterpolator = interpolator( type );
+
+        if ( m_typedInterpolator == nullptr )
+        {
+            // all what has been registered by qRegisterAnimationInterpolator
+            m_interpolator = reinterpret_cast< void (*)() >(
+                QVariantAnimationPrivate::getInterpolator( type ) );
+        }
     }
 
-    m_currentValue = m_interpolator ? m_startValue : m_endValue;
+    if ( m_typedInterpolator )
+    {
+        m_currentValue = m_startValue;
+
+        // detaching once, so that we can interpolate in place later
+        m_currentValue.detach();
+    }
+    else
+    {
+        m_currentValue = m_interpolator ? m_startValue : m_endValue;
+    }
 }
 
 void QskVariantAnimator::advance( qreal progress )
 {
-    if ( m_interpolator )
+    ( void )interpolate( progress );
+}
+
+bool QskVariantAnimator::interpolate( qreal progress )
+{
+    if ( qFuzzyCompare( progress, 1.0 ) )
+        progress = 1.0;
+
+    if ( m_typedInterpolator )
     {
-        if ( qFuzzyCompare( progress, 1.0 ) )
-            progress = 1.0;
+        /*
+            As long as nobody holds a copy of m_currentValue
+            data() does not detach and the value is updated in place
+         */
+        return m_typedInterpolator( m_startValue.constData(),
+            m_endValue.constData(), progress, m_currentValue.data() );
+    }
 
-        m_currentValue = qskInterpolate( m_interpolator,
+    if ( m_interpolator )
+    {
+        const auto value = qskInterpolate( m_interpolator,
             m_startValue, m_endValue, progress );
+
+        if ( value != m_currentValue )
+        {
+            m_currentValue = value;
+            return true;
+        }
     }
+
+    return false;
 }
 
 void QskVariantAnimator::done()
 {
     m_interpolator = nullptr;
+    m_typedInterpolator = nullptr;
 }
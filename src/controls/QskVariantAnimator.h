@@ -13,11 +13,20 @@
 class QSK_EXPORT QskVariantAnimator : public QskAnimator
 {
 public:
+    /*
+        An interpolator, that updates value in place
+        and returns whether it has been changed
+     */
+    typedef bool ( *Interpolator )(
+        const void* from, const void* to, qreal progress, void* value );
+
     QskVariantAnimator();
     virtual ~QskVariantAnimator();
 
+    static Interpolator interpolator( int userType );
+
     void setCurrentValue( const QVariant& );
-    QVariant currentValue() const;
+    const QVariant& currentValue() const;
 
     void setStartValue( const QVariant& );
     QVariant startValue() const;
@@ -30,12 +39,15 @@ protected:
     virtual void advance( qreal value ) override;
     virtual void done() override;
 
+    bool interpolate( qreal progress );
+
 private:
     QVariant m_startValue;
     QVariant m_endValue;
     QVariant m_currentValue;
 
     void( *m_interpolator )();
+    Interpolator m_typedInterpolator;
 };
 
 inline QVariant QskVariantAnimator::startValue() const
@@ -48,7 +60,7 @@ inline QVariant QskVariantAnimator::endValue() const
     return m_endValue;
 }
 
-inline QVariant QskVariantAnimator::currentValue() const
+inline const QVariant& QskVariantAnimator::currentValue() const
 {
     return m_currentValue;
 }
@@ -0,0 +1,673 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskVirtualBox.h"
+#include "QskScrollArea.h"
+#include "QskLayoutConstraint.h"
+#include "QskLayoutEngine.h"
+#include "QskEvent.h"
+
+#include <QHash>
+#include <QQuickWindow>
+#include <QVector>
+
+#include <vector>
+
+static inline QskSizePolicy qskSizePolicy( Qt::Orientation orientation )
+{
+    // growing into the viewport, but having the height/width of the lines
+
+    if ( orientation == Qt::Vertical )
+        return QskSizePolicy( QskSizePolicy::Minimum, QskSizePolicy::Fixed );
+    else
+        return QskSizePolicy( QskSizePolicy::Fixed, QskSizePolicy::Minimum );
+}
+
+static inline qreal qskItemExtent( const QQuickItem* item,
+    Qt::Orientation orientation, qreal cellExtent )
+{
+    using namespace QskLayoutConstraint;
+
+    if ( orientation == Qt::Vertical )
+    {
+        if ( hasDynamicConstraint( item ) )
+            return heightForWidth( item, cellExtent );
+
+        return effectiveConstraint( item, Qt::PreferredSize ).height();
+    }
+    else
+    {
+        if ( hasDynamicConstraint( item ) )
+            return widthForHeight( item, cellExtent );
+
+        return effectiveConstraint( item, Qt::PreferredSize ).width();
+    }
+}
+
+namespace
+{
+    /*
+        The offset of a line is its estimated offset plus the deviations
+        of all measured lines in front of it. The deviations are stored in a
+        Fenwick tree, so that finding offsets and the line at a position
+        is O(log n) - regardless of how many lines have been measured.
+     */
+
+    class LineTable
+    {
+    public:
+        LineTable():
+            m_estimate( 0.0 ),
+            m_spacing( 0.0 )
+        {
+        }
+
+        void reset( int count )
+        {
+            m_extents.assign( count, -1.0 );
+            m_tree.assign( count + 1, 0.0 );
+        }
+
+        void setEstimate( qreal estimate, qreal spacing )
+        {
+            m_estimate = estimate;
+            m_spacing = spacing;
+
+            // the deviations are relative to the estimate
+
+            std::fill( m_tree.begin(), m_tree.end(), 0.0 );
+
+            for ( int line = 0; line < count(); line++ )
+            {
+                if ( isMeasured( line ) )
+                    add( line, m_extents[ line ] - m_estimate );
+            }
+        }
+
+        inline qreal estimate() const
+        {
+            return m_estimate;
+        }
+
+        inline int count() const
+        {
+            return static_cast< int >( m_extents.size() );
+        }
+
+        inline bool isMeasured( int line ) const
+        {
+            return m_extents[ line ] >= 0.0;
+        }
+
+        inline qreal extent( int line ) const
+        {
+            return isMeasured( line ) ? m_extents[ line ] : m_estimate;
+        }
+
+        void setExtent( int line, qreal extent )
+        {
+            const qreal oldExtent = this->extent( line );
+
+            m_extents[ line ] = extent;
+
+            const qreal delta = this->extent( line ) - oldExtent;
+            if ( delta != 0.0 )
+                add( line, delta );
+        }
+
+        qreal offset( int line ) const
+        {
+            qreal offset = line * ( m_estimate + m_spacing );
+
+            for ( int i = line; i > 0; i -= ( i & -i ) )
+                offset += m_tree[ i ];
+
+            return offset;
+        }
+
+        qreal totalExtent() const
+        {
+            const int n = count();
+            return ( n > 0 ) ? offset( n ) - m_spacing : 0.0;
+        }
+
+        int lineAt( qreal pos ) const
+        {
+            // the last line starting at or before pos
+
+            const int n = count();
+            if ( n == 0 )
+                return -1;
+
+            int bit = 1;
+            while ( 2 * bit <= n )
+                bit *= 2;
+
+            int line = 0;
+            qreal sum = 0.0;
+
+            for ( ; bit > 0; bit /= 2 )
+            {
+                const int next = line + bit;
+                if ( next > n )
+                    continue;
+
+                const qreal offset = next * ( m_estimate + m_spacing ) + sum + m_tree[ next ];
+                if ( offset <= pos )
+                {
+                    line = next;
+                    sum += m_tree[ next ];
+                }
+            }
+
+            return qMin( line, n - 1 );
+        }
+
+    private:
+        void add( int line, qreal delta )
+        {
+            const int n = count();
+
+            for ( int i = line + 1; i <= n; i += ( i & -i ) )
+                m_tree[ i ] += delta;
+        }
+
+        qreal m_estimate;
+        qreal m_spacing;
+
+        std::vector< qreal > m_extents; // < 0: not measured
+        std::vector< qreal > m_tree;
+    };
+}
+
+class QskVirtualBox::PrivateData
+{
+public:
+    PrivateData( Qt::Orientation orientation, uint dimension ):
+        orientation( orientation ),
+        dimension( qMax( dimension, 1u ) ),
+        count( 0 ),
+        spacing( QskLayoutEngine::defaultSpacing( orientation ) ),
+        estimatedItemSize( -1.0, -1.0 ),
+        cellExtent( -1.0 ),
+        hasEstimate( false ),
+        isLayouting( false ),
+        remeasure( false )
+    {
+    }
+
+    inline int lineCount() const
+    {
+        return ( count + int( dimension ) - 1 ) / int( dimension );
+    }
+
+    inline qreal estimatedExtent( Qt::Orientation o ) const
+    {
+        return ( o == Qt::Vertical )
+            ? estimatedItemSize.height() : estimatedItemSize.width();
+    }
+
+    Qt::Orientation orientation;
+    uint dimension;
+    int count;
+    qreal spacing;
+
+    QSizeF estimatedItemSize;
+
+    LineTable lines;
+    qreal cellExtent; // in the direction of the lines
+
+    QHash< int, QQuickItem* > items; // the instantiated entries
+    QVector< QQuickItem* > pool; // items for recycling
+
+    bool hasEstimate : 1;
+    bool isLayouting : 1;
+    bool remeasure : 1;
+};
+
+QskVirtualBox::QskVirtualBox( QQuickItem* parent ):
+    QskVirtualBox( Qt::Vertical, 1, parent )
+{
+}
+
+QskVirtualBox::QskVirtualBox( Qt::Orientation orientation,
+        uint dimension, QQuickItem* parent ):
+    Inherited( parent ),
+    m_data( new PrivateData( orientation, dimension ) )
+{
+    setPolishOnResize( true );
+    setSizePolicy( qskSizePolicy( orientation ) );
+}
+
+QskVirtualBox::~QskVirtualBox()
+{
+}
+
+Qt::Orientation QskVirtualBox::orientation() const
+{
+    return m_data->orientation;
+}
+
+void QskVirtualBox::setOrientation( Qt::Orientation orientation )
+{
+    if ( orientation != m_data->orientation )
+    {
+        m_data->orientation = orientation;
+        setSizePolicy( qskSizePolicy( orientation ) );
+
+        resetLines();
+
+        Q_EMIT orientationChanged();
+    }
+}
+
+void QskVirtualBox::setDimension( uint dimension )
+{
+    dimension = qMax( dimension, 1u );
+
+    if ( dimension != m_data->dimension )
+    {
+        m_data->dimension = dimension;
+        resetLines();
+
+        Q_EMIT dimensionChanged();
+    }
+}
+
+uint QskVirtualBox::dimension() const
+{
+    return m_data->dimension;
+}
+
+void QskVirtualBox::setCount( int count )
+{
+    count = qMax( count, 0 );
+
+    if ( count != m_data->count )
+    {
+        m_data->count = count;
+        resetLines();
+
+        Q_EMIT countChanged();
+    }
+}
+
+int QskVirtualBox::count() const
+{
+    return m_data->count;
+}
+
+void QskVirtualBox::setSpacing( qreal spacing )
+{
+    spacing = qMax( spacing, 0.0 );
+
+    if ( spacing != m_data->spacing )
+    {
+        m_data->spacing = spacing;
+        m_data->lines.setEstimate( m_data->lines.estimate(), spacing );
+
+        m_data->cellExtent = -1.0;
+
+        resetImplicitSize();
+        polish();
+
+        Q_EMIT spacingChanged();
+    }
+}
+
+void QskVirtualBox::resetSpacing()
+{
+    setSpacing( QskLayoutEngine::defaultSpacing( m_data->orientation ) );
+}
+
+qreal QskVirtualBox::spacing() const
+{
+    return m_data->spacing;
+}
+
+void QskVirtualBox::setEstimatedItemSize( const QSizeF& size )
+{
+    if ( size != m_data->estimatedItemSize )
+    {
+        m_data->estimatedItemSize = size;
+        resetLines();
+
+        Q_EMIT estimatedItemSizeChanged();
+    }
+}
+
+QSizeF QskVirtualBox::estimatedItemSize() const
+{
+    return m_data->estimatedItemSize;
+}
+
+QQuickItem* QskVirtualBox::itemAtIndex( int index ) const
+{
+    return m_data->items.value( index, nullptr );
+}
+
+QRectF QskVirtualBox::itemRect( int index ) const
+{
+    if ( index < 0 || index >= m_data->count )
+        return QRectF();
+
+    const auto& lines = m_data->lines;
+
+    const int dim = int( m_data->dimension );
+    const int line = index / dim;
+
+    const QRectF rect = contentsRect();
+
+    const qreal cellExtent = qMax( m_data->cellExtent, 0.0 );
+    const qreal cellPos = ( index % dim ) * ( cellExtent + m_data->spacing );
+
+    if ( m_data->orientation == Qt::Vertical )
+    {
+        return QRectF( rect.x() + cellPos, rect.y() + lines.offset( line ),
+            cellExtent, lines.extent( line ) );
+    }
+    else
+    {
+        return QRectF( rect.x() + lines.offset( line ), rect.y() + cellPos,
+            lines.extent( line ), cellExtent );
+    }
+}
+
+void QskVirtualBox::invalidateItems()
+{
+    resetLines();
+}
+
+QSizeF QskVirtualBox::contentsSizeHint() const
+{
+    const auto orientation = m_data->orientation;
+    const int dim = int( m_data->dimension );
+
+    const qreal extent = m_data->lines.totalExtent();
+
+    const qreal estimate = m_data->estimatedExtent(
+        ( orientation == Qt::Vertical ) ? Qt::Horizontal : Qt::Vertical );
+
+    qreal cellsExtent = 0.0;
+    if ( estimate > 0.0 )
+        cellsExtent = dim * estimate + ( dim - 1 ) * m_data->spacing;
+
+    if ( orientation == Qt::Vertical )
+        return QSizeF( cellsExtent, extent );
+    else
+        return QSizeF( extent, cellsExtent );
+}
+
+bool QskVirtualBox::event( QEvent* event )
+{
+    if ( event->type() == QEvent::LayoutRequest )
+    {
+        /*
+            One of the instantiated items has changed its hints. As we
+            don't know which one, all visible lines are measured again.
+            Requests, that result from our own updates, can be ignored.
+         */
+        if ( !m_data->isLayouting )
+        {
+            m_data->remeasure = true;
+            polish();
+        }
+    }
+
+    return Inherited::event( event );
+}
+
+void QskVirtualBox::geometryChangeEvent( QskGeometryChangeEvent* event )
+{
+    Inherited::geometryChangeEvent( event );
+
+    // the enclosing scroll area moves us around, when scrolling
+    if ( event->isMoved() )
+        polish();
+}
+
+void QskVirtualBox::updateLayout()
+{
+    auto& lines = m_data->lines;
+
+    const int lineCount = lines.count();
+    if ( lineCount == 0 )
+    {
+        retainItems( 0, 0 );
+        return;
+    }
+
+    m_data->isLayouting = true;
+
+    const auto orientation = m_data->orientation;
+    const int dim = int( m_data->dimension );
+    const qreal spacing = m_data->spacing;
+
+    const QRectF rect = contentsRect();
+
+    {
+        const qreal length = ( orientation == Qt::Vertical ) ? rect.width() : rect.height();
+        const qreal cellExtent = qMax( ( length - ( dim - 1 ) * spacing ) / dim, 0.0 );
+
+        if ( cellExtent != m_data->cellExtent )
+        {
+            // heightForWidth/widthForHeight depend on the cell extent
+            m_data->cellExtent = cellExtent;
+            lines.reset( lineCount );
+        }
+    }
+
+    const QRectF viewport = viewportRect();
+
+    qreal pos, from, to;
+    if ( orientation == Qt::Vertical )
+    {
+        pos = rect.y();
+        from = viewport.top() - pos;
+        to = viewport.bottom() - pos;
+    }
+    else
+    {
+        pos = rect.x();
+        from = viewport.left() - pos;
+        to = viewport.right() - pos;
+    }
+
+    /*
+        Measuring changes the offsets of the following lines and might bring
+        other lines into the viewport. As lines are measured only once,
+        this converges after a couple of iterations.
+     */
+
+    bool remeasure = m_data->remeasure;
+    m_data->remeasure = false;
+
+    bool hasChanged = false;
+    int firstLine = 0;
+    int lastLine = 0;
+
+    for ( int i = 0; i < 10; i++ )
+    {
+        if ( !m_data->hasEstimate )
+            hasChanged |= measureLines( 0, 0, false );
+
+        firstLine = lines.lineAt( from );
+        lastLine = lines.lineAt( to );
+
+        if ( !measureLines( firstLine, lastLine, remeasure ) )
+            break;
+
+        hasChanged = true;
+        remeasure = false;
+    }
+
+    retainItems( firstLine * dim, qMin( ( lastLine + 1 ) * dim, m_data->count ) );
+
+    const qreal cellExtent = m_data->cellExtent;
+    const qreal cellPos = ( orientation == Qt::Vertical ) ? rect.x() : rect.y();
+
+    for ( int line = firstLine; line <= lastLine; line++ )
+    {
+        const qreal linePos = pos + lines.offset( line );
+        const qreal lineExtent = lines.extent( line );
+
+        for ( int i = 0; i < dim; i++ )
+        {
+            auto item = m_data->items.value( line * dim + i, nullptr );
+            if ( item == nullptr )
+                continue;
+
+            const qreal p = cellPos + i * ( cellExtent + spacing );
+
+            if ( orientation == Qt::Vertical )
+                qskSetItemGeometry( item, QRectF( p, linePos, cellExtent, lineExtent ) );
+            else
+                qskSetItemGeometry( item, QRectF( linePos, p, lineExtent, cellExtent ) );
+        }
+    }
+
+    m_data->isLayouting = false;
+
+    if ( hasChanged )
+        resetImplicitSize();
+}
+
+bool QskVirtualBox::measureLines( int firstLine, int lastLine, bool force )
+{
+    auto& lines = m_data->lines;
+
+    const int dim = int( m_data->dimension );
+
+    bool hasChanged = false;
+
+    for ( int line = firstLine; line <= lastLine; line++ )
+    {
+        const bool doMeasure = force || !lines.isMeasured( line );
+
+        const int from = line * dim;
+        const int to = qMin( from + dim, m_data->count );
+
+        qreal extent = 0.0;
+
+        for ( int index = from; index < to; index++ )
+        {
+            auto item = acquireItem( index );
+
+            if ( item && doMeasure )
+            {
+                extent = qMax( extent, qskItemExtent( item,
+                    m_data->orientation, m_data->cellExtent ) );
+            }
+        }
+
+        if ( !doMeasure )
+            continue;
+
+        if ( !m_data->hasEstimate )
+        {
+            qreal estimate = m_data->estimatedExtent( m_data->orientation );
+            if ( estimate <= 0.0 )
+                estimate = extent;
+
+            // lines without any extent would all be "visible"
+            lines.setEstimate( qMax( estimate, 1.0 ), m_data->spacing );
+            m_data->hasEstimate = true;
+
+            hasChanged = true;
+        }
+
+        if ( extent != lines.extent( line ) )
+            hasChanged = true;
+
+        lines.setExtent( line, extent );
+    }
+
+    return hasChanged;
+}
+
+void QskVirtualBox::resetLines()
+{
+    retainItems( 0, 0 );
+
+    m_data->lines.reset( m_data->lineCount() );
+
+    const qreal estimate = m_data->estimatedExtent( m_data->orientation );
+
+    m_data->hasEstimate = ( estimate > 0.0 );
+    m_data->lines.setEstimate( qMax( estimate, 0.0 ), m_data->spacing );
+
+    resetImplicitSize();
+    polish();
+}
+
+QQuickItem* QskVirtualBox::acquireItem( int index )
+{
+    auto item = m_data->items.value( index, nullptr );
+    if ( item )
+        return item;
+
+    if ( !m_data->pool.isEmpty() )
+    {
+        item = m_data->pool.takeLast();
+    }
+    else
+    {
+        item = createItem();
+        if ( item == nullptr )
+            return nullptr;
+
+        item->setParentItem( this );
+        if ( item->parent() == nullptr )
+            item->setParent( this );
+    }
+
+    updateItem( item, index );
+    item->setVisible( true );
+
+    m_data->items.insert( index, item );
+
+    return item;
+}
+
+void QskVirtualBox::retainItems( int from, int to )
+{
+    // all items outside of [from, to[ are moved to the pool
+
+    auto& items = m_data->items;
+
+    for ( auto it = items.begin(); it != items.end(); )
+    {
+        if ( it.key() < from || it.key() >= to )
+        {
+            auto item = it.value();
+            item->setVisible( false );
+
+            m_data->pool += item;
+            it = items.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+QRectF QskVirtualBox::viewportRect() const
+{
+    for ( auto item = parentItem(); item; item = item->parentItem() )
+    {
+        if ( auto scrollArea = qobject_cast< const QskScrollArea* >( item ) )
+            return mapRectFromItem( scrollArea, scrollArea->viewContentsRect() );
+    }
+
+    // without a scroll area we instantiate what is inside the window
+
+    if ( window() )
+        return mapRectFromScene( QRectF( QPointF(), window()->size() ) );
+
+    return rect();
+}
+
+#include "moc_QskVirtualBox.cpp"
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_VIRTUAL_BOX_H
+#define QSK_VIRTUAL_BOX_H
+
+#include "QskControl.h"
+
+/*
+    QskVirtualBox arranges count() entries in lines like a QskLinearBox
+    with a dimension, but only the entries intersecting the viewport
+    of the enclosing QskScrollArea are instantiated. Items are taken
+    from createItem() and recycled for other entries, when scrolling.
+
+    Lines, that have not been visible yet, are assumed to have the
+    estimatedItemSize(), so that the costs do not depend on count().
+ */
+
+class QSK_EXPORT QskVirtualBox : public QskControl
+{
+    Q_OBJECT
+
+    Q_PROPERTY( Qt::Orientation orientation READ orientation
+        WRITE setOrientation NOTIFY orientationChanged FINAL )
+
+    Q_PROPERTY( uint dimension READ dimension
+        WRITE setDimension NOTIFY dimensionChanged FINAL )
+
+    Q_PROPERTY( int count READ count WRITE setCount NOTIFY countChanged FINAL )
+
+    Q_PROPERTY( qreal spacing READ spacing
+        WRITE setSpacing RESET resetSpacing NOTIFY spacingChanged FINAL )
+
+    Q_PROPERTY( QSizeF estimatedItemSize READ estimatedItemSize
+        WRITE setEstimatedItemSize NOTIFY estimatedItemSizeChanged FINAL )
+
+    using Inherited = QskControl;
+
+public:
+    QskVirtualBox( QQuickItem* parent = nullptr );
+    QskVirtualBox( Qt::Orientation, uint dimension, QQuickItem* parent = nullptr );
+
+    virtual ~QskVirtualBox();
+
+    Qt::Orientation orientation() const;
+    void setOrientation( Qt::Orientation );
+
+    void setDimension( uint );
+    uint dimension() const;
+
+    void setCount( int );
+    int count() const;
+
+    void setSpacing( qreal spacing );
+    void resetSpacing();
+    qreal spacing() const;
+
+    /*
+        When no estimated size has been set, the size of
+        the first line is used as estimation.
+     */
+    void setEstimatedItemSize( const QSizeF& );
+    QSizeF estimatedItemSize() const;
+
+    // nullptr, when the entry is not instantiated
+    Q_INVOKABLE QQuickItem* itemAtIndex( int index ) const;
+
+    // geometry of an entry - estimated, when not having been measured
+    Q_INVOKABLE QRectF itemRect( int index ) const;
+
+    // entries have to be updated and measured again
+    Q_INVOKABLE void invalidateItems();
+
+    virtual QSizeF contentsSizeHint() const override;
+
+Q_SIGNALS:
+    void orientationChanged();
+    void dimensionChanged();
+    void countChanged();
+    void spacingChanged();
+    void estimatedItemSizeChanged();
+
+protected:
+    virtual QQuickItem* createItem() = 0;
+    virtual void updateItem( QQuickItem*, int index ) = 0;
+
+    virtual bool event( QEvent* ) override;
+    virtual void geometryChangeEvent( QskGeometryChangeEvent* ) override;
+
+    virtual void updateLayout() override;
+
+private:
+    QRectF viewportRect() const;
+
+    QQuickItem* acquireItem( int index );
+    void retainItems( int from, int to );
+
+    bool measureLines( int firstLine, int lastLine, bool force );
+    void resetLines();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -9,9 +9,13 @@
 #include "QskSetup.h"
 #include "QskSkin.h"
 #include "QskEvent.h"
+#include "QskFrameProfiler.h"
 
 #include <QtMath>
 #include <QPointer>
+#include <QElapsedTimer>
+
+#include <memory>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -23,6 +27,8 @@ QSK_QT_PRIVATE_END
 static void qskResolveLocale( QskWindow* );
 static bool qskEnforcedSkin = false;
 
+extern bool qskSetPolishDeferred( QskControl*, bool on );
+
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
     QEvent event( type );
@@ -101,6 +107,8 @@ class QskWindowPrivate : public QQuickWindowPrivate
 public:
     QskWindowPrivate():
         preferredSize( -1, -1 ),
+        polishBudget( 0 ),
+        deferredPolishCount( 0 ),
         explicitLocale( false ),
         deleteOnClose( false ),
         autoLayoutChildren( true )
@@ -113,6 +121,21 @@ public:
     // minimum/maximum constraints are offered by QWindow
     QSize preferredSize;
 
+    /*
+        With a polish budget controls are polished only until the
+        budget is exceeded. The rest is deferred to the following frames.
+     */
+    int polishBudget;
+    QElapsedTimer polishTimer;
+    QVector< QPointer< QskControl > > deferredPolishItems;
+    int deferredPolishCount; // deferred during the last polish pass
+
+    /*
+        The profiler is never deleted before the window, as the scene graph
+        thread might still be inside of one of its hooks.
+     */
+    std::unique_ptr< QskFrameProfiler > profiler;
+
     bool explicitLocale : 1;
     bool deleteOnClose : 1;
     bool autoLayoutChildren : 1;
@@ -133,6 +156,13 @@ QskWindow::QskWindow( QWindow* parent ):
 
     d_func()->contentItemListener.setEnabled( contentItem(), true );
 
+    /*
+        The render loops emit afterAnimating in the GUI thread, right
+        after the polish pass and before synchronizing the scene graph.
+     */
+    connect( this, &QQuickWindow::afterAnimating,
+        this, &QskWindow::finishPolishPass );
+
     if ( !qskEnforcedSkin )
         connect( this, &QQuickWindow::afterAnimating, this, &QskWindow::enforceSkin );
 }
@@ -154,6 +184,14 @@ QskWindow::~QskWindow()
 
     for ( auto item : qskAsConst( items ) )
         delete item;
+
+    Q_D( QskWindow );
+
+    for ( const auto& control : qskAsConst( d->deferredPolishItems ) )
+    {
+        if ( control )
+            qskSetPolishDeferred( control, false );
+    }
 }
 
 void QskWindow::resizeF( const QSizeF& size )
@@ -214,6 +252,140 @@ void QskWindow::polishItems()
 {
     Q_D( QskWindow );
     d->polishItems();
+
+    // polishing without the render loop
+    finishPolishPass();
+}
+
+void QskWindow::setPolishBudget( int msecs )
+{
+    Q_D( QskWindow );
+    d->polishBudget = qMax( msecs, 0 );
+}
+
+int QskWindow::polishBudget() const
+{
+    Q_D( const QskWindow );
+    return d->polishBudget;
+}
+
+int QskWindow::deferredPolishCount() const
+{
+    Q_D( const QskWindow );
+    return d->deferredPolishCount;
+}
+
+void QskWindow::finishPolishPass()
+{
+    Q_D( QskWindow );
+
+    if ( !d->polishTimer.isValid() )
+    {
+        // nothing has been polished
+        d->deferredPolishCount = 0;
+        return;
+    }
+
+    d->polishTimer.invalidate();
+
+    if ( !d->deferredPolishItems.isEmpty() )
+    {
+        // polishing the rest in one of the following frames
+        QCoreApplication::postEvent( this, new QEvent( QEvent::PolishRequest ) );
+    }
+}
+
+void QskWindow::polishDeferredItems()
+{
+    Q_D( QskWindow );
+
+    /*
+        Controls, that are visible inside of the window, are polished first.
+        The others have to wait until no visible control is left.
+     */
+
+    const QRectF windowRect( 0, 0, width(), height() );
+
+    QVector< QPointer< QskControl > > pendingItems;
+    bool hasVisibleItems = false;
+
+    for ( const auto& control : qskAsConst( d->deferredPolishItems ) )
+    {
+        if ( control.isNull() )
+            continue;
+
+        if ( control->window() != this )
+        {
+            // the control has been moved: polishing it in its new window
+            qskSetPolishDeferred( control, false );
+            control->polish();
+
+            continue;
+        }
+
+        if ( control->isVisible() && control->mapRectToScene(
+            QRectF( 0, 0, control->width(), control->height() ) ).intersects( windowRect ) )
+        {
+            qskSetPolishDeferred( control, false );
+            control->polish();
+
+            hasVisibleItems = true;
+        }
+        else
+        {
+            pendingItems += control;
+        }
+    }
+
+    if ( !hasVisibleItems )
+    {
+        for ( const auto& control : qskAsConst( pendingItems ) )
+        {
+            qskSetPolishDeferred( control, false );
+            control->polish();
+        }
+
+        pendingItems.clear();
+    }
+
+    d->deferredPolishItems = pendingItems;
+}
+
+// not static as being used from QskControl.cpp
+bool qskDeferPolish( QskControl* control )
+{
+    /*
+        Returns true, when the polish budget of the window has been exceeded.
+        Then the control is polished in one of the following frames.
+     */
+
+    auto window = qobject_cast< QskWindow* >( control->window() );
+    if ( window == nullptr )
+        return false;
+
+    auto d = static_cast< QskWindowPrivate* >( QQuickWindowPrivate::get( window ) );
+    if ( d->polishBudget <= 0 )
+        return false;
+
+    if ( !d->polishTimer.isValid() )
+    {
+        // first polish of this pass
+        d->polishTimer.start();
+        d->deferredPolishCount = 0;
+
+        return false;
+    }
+
+    if ( d->polishTimer.elapsed() < d->polishBudget )
+        return false;
+
+    // a flag of the control avoids searching the list
+    if ( !qskSetPolishDeferred( control, true ) )
+        d->deferredPolishItems += control;
+
+    d->deferredPolishCount++;
+
+    return true;
 }
 
 bool QskWindow::event( QEvent* event )
@@ -237,6 +409,11 @@ bool QskWindow::event( QEvent* event )
                 layoutItems();
             break;
         }
+        case QEvent::PolishRequest:
+        {
+            polishDeferredItems();
+            break;
+        }
         case QEvent::LocaleChange:
         {
             Q_EMIT localeChanged( locale() );
@@ -507,6 +684,31 @@ const char* QskWindow::customRenderMode() const
     return d->customRenderMode;
 }
 
+void QskWindow::setProfiling( bool on )
+{
+    Q_D( QskWindow );
+
+    if ( on == isProfiling() )
+        return;
+
+    if ( d->profiler == nullptr )
+        d->profiler.reset( new QskFrameProfiler( this ) );
+
+    d->profiler->setEnabled( on );
+}
+
+bool QskWindow::isProfiling() const
+{
+    Q_D( const QskWindow );
+    return d->profiler && d->profiler->isEnabled();
+}
+
+QskFrameProfiler* QskWindow::profiler() const
+{
+    Q_D( const QskWindow );
+    return d->profiler.get();
+}
+
 void QskWindow::enforceSkin()
 {
     if ( !qskEnforcedSkin )
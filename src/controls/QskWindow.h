@@ -11,6 +11,7 @@
 
 class QskWindowPrivate;
 class QskObjectAttributes;
+class QskFrameProfiler;
 
 class QSK_EXPORT QskWindow : public QQuickWindow
 {
@@ -51,9 +52,19 @@ public:
 
     void polishItems();
 
+    void setPolishBudget( int msecs );
+    int polishBudget() const;
+
+    int deferredPolishCount() const;
+
     void setCustomRenderMode( const char* mode );
     const char* customRenderMode() const;
 
+    void setProfiling( bool );
+    bool isProfiling() const;
+
+    QskFrameProfiler* profiler() const;
+
 Q_SIGNALS:
     void localeChanged( const QLocale& );
     void autoLayoutChildrenChanged();
@@ -76,6 +87,9 @@ protected:
 private:
     void enforceSkin();
 
+    void finishPolishPass();
+    void polishDeferredItems();
+
     Q_DECLARE_PRIVATE( QskWindow )
 };
 
@@ -6,8 +6,6 @@
 #include "QskGridBox.h"
 #include "QskLayoutItem.h"
 #include "QskLayoutEngine.h"
-#include <private/qabstractlayoutstyleinfo_p.h>
-#include <private/qgridlayoutengine_p.h>
 
 class QskGridBox::PrivateData
 {
@@ -49,11 +47,17 @@ void QskGridBox::addItem( QQuickItem* item,
 
 int QskGridBox::rowCount() const
 {
+    if ( engine().hasStaticTracks( Qt::Vertical ) )
+        return engine().staticTrackCount( Qt::Vertical );
+
     return engine().effectiveLastRow( Qt::Vertical ) + 1;
 }
 
 int QskGridBox::columnCount() const
 {
+    if ( engine().hasStaticTracks( Qt::Horizontal ) )
+        return engine().staticTrackCount( Qt::Horizontal );
+
     return engine().effectiveLastRow( Qt::Horizontal ) + 1;
 }
 
@@ -113,8 +117,15 @@ void QskGridBox::setupLayoutItem( QskLayoutItem* layoutItem, int index )
 
     QskLayoutEngine& engine = this->engine();
 
-    m_data->isExpanding = ( layoutItem->lastColumn() >= engine.columnCount() ) ||
-        ( layoutItem->lastRow() >= engine.rowCount() );
+    // static tracks are never extended by the items
+
+    const bool expandsColumns = !engine.hasStaticTracks( Qt::Horizontal )
+        && ( layoutItem->lastColumn() >= engine.columnCount() );
+
+    const bool expandsRows = !engine.hasStaticTracks( Qt::Vertical )
+        && ( layoutItem->lastRow() >= engine.rowCount() );
+
+    m_data->isExpanding = expandsColumns || expandsRows;
 }
 
 void QskGridBox::layoutItemInserted( QskLayoutItem* layoutItem, int index )
@@ -159,20 +170,31 @@ void QskGridBox::layoutItemRemoved( QskLayoutItem* layoutItem, int index )
 
     QskLayoutEngine& engine = this->engine();
 
+    const bool hasStaticColumns = engine.hasStaticTracks( Qt::Horizontal );
+    const bool hasStaticRows = engine.hasStaticTracks( Qt::Vertical );
+
+    if ( hasStaticColumns && hasStaticRows )
+        return; // the structure of a static grid does not depend on its items
+
     // cleanup rows/columns
 
     const QSize cells = engine.requiredCells();
 
-    const int numPendingColumns = engine.columnCount() - cells.width();
-    const int numPendingRows = engine.rowCount() - cells.height();
+    const int numPendingColumns =
+        hasStaticColumns ? 0 : engine.columnCount() - cells.width();
+
+    const int numPendingRows =
+        hasStaticRows ? 0 : engine.rowCount() - cells.height();
 
     if ( numPendingColumns > 0 || numPendingRows > 0 )
     {
-        if ( m_data->unlimitedSpanned > 0 )
-            engine.adjustSpans( cells.height(), cells.width() );
+        adjustUnlimitedSpans();
 
-        engine.removeRows( cells.width(), numPendingColumns,  Qt::Horizontal );
-        engine.removeRows( cells.height(), numPendingRows,  Qt::Vertical );
+        if ( numPendingColumns > 0 )
+            engine.removeRows( cells.width(), numPendingColumns,  Qt::Horizontal );
+
+        if ( numPendingRows > 0 )
+            engine.removeRows( cells.height(), numPendingRows,  Qt::Vertical );
     }
 }
 
@@ -362,6 +384,42 @@ void QskGridBox::setColumnFixedWidth( int column, qreal width )
     setColumnMaximumWidth( column, width );
 }
 
+void QskGridBox::setStaticRows( const QVector< qreal >& heights, Qt::SizeMode mode )
+{
+    setStaticTracks( heights, mode, Qt::Vertical );
+}
+
+QVector< qreal > QskGridBox::staticRows() const
+{
+    return engine().staticTracks( Qt::Vertical );
+}
+
+bool QskGridBox::hasStaticRows() const
+{
+    return engine().hasStaticTracks( Qt::Vertical );
+}
+
+void QskGridBox::setStaticColumns( const QVector< qreal >& widths, Qt::SizeMode mode )
+{
+    setStaticTracks( widths, mode, Qt::Horizontal );
+}
+
+QVector< qreal > QskGridBox::staticColumns() const
+{
+    return engine().staticTracks( Qt::Horizontal );
+}
+
+bool QskGridBox::hasStaticColumns() const
+{
+    return engine().hasStaticTracks( Qt::Horizontal );
+}
+
+void QskGridBox::resetStaticGrid()
+{
+    setStaticTracks( QVector< qreal >(), Qt::AbsoluteSize, Qt::Horizontal );
+    setStaticTracks( QVector< qreal >(), Qt::AbsoluteSize, Qt::Vertical );
+}
+
 void QskGridBox::setRowAlignment( int row, Qt::Alignment alignment )
 {
     if ( engine().rowAlignment( row, Qt::Vertical ) != alignment )
@@ -461,4 +519,38 @@ void QskGridBox::setRowSizeHint(
     }
 }
 
+void QskGridBox::setStaticTracks( const QVector< qreal >& tracks,
+    Qt::SizeMode mode, Qt::Orientation orientation )
+{
+    auto& engine = this->engine();
+
+    if ( tracks == engine.staticTracks( orientation )
+        && mode == engine.staticTrackMode( orientation ) )
+    {
+        return;
+    }
+
+    engine.setStaticTracks( tracks, mode, orientation );
+
+    adjustUnlimitedSpans();
+    invalidate();
+}
+
+void QskGridBox::adjustUnlimitedSpans()
+{
+    if ( m_data->unlimitedSpanned == 0 )
+        return;
+
+    /*
+        Items without fixed spanning fill the static tracks or
+        all rows/columns, that are required by the other items.
+     */
+    const QSize cells = engine().requiredCells();
+
+    const int numRows = hasStaticRows() ? rowCount() : cells.height();
+    const int numColumns = hasStaticColumns() ? columnCount() : cells.width();
+
+    engine().adjustSpans( numRows, numColumns );
+}
+
 #include "moc_QskGridBox.cpp"
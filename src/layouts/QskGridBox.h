@@ -9,6 +9,8 @@
 #include "QskGlobal.h"
 #include "QskLayout.h"
 
+#include <QVector>
+
 class QSK_EXPORT QskGridBox : public QskLayout
 {
     Q_OBJECT
@@ -94,6 +96,26 @@ public:
 
     Q_INVOKABLE void setColumnFixedWidth( int column, qreal width );
 
+    /*
+        A static grid has a fixed number of rows/columns, where the sizes
+        are given in pixels or as fractions of the available space. Empty
+        rows/columns keep their space and the children are simply placed
+        into their cells without resolving any size hints or spans.
+     */
+    void setStaticRows( const QVector< qreal >& heights,
+        Qt::SizeMode = Qt::AbsoluteSize );
+
+    QVector< qreal > staticRows() const;
+    bool hasStaticRows() const;
+
+    void setStaticColumns( const QVector< qreal >& widths,
+        Qt::SizeMode = Qt::AbsoluteSize );
+
+    QVector< qreal > staticColumns() const;
+    bool hasStaticColumns() const;
+
+    void resetStaticGrid();
+
     // alignments
 
     Q_INVOKABLE void setRowAlignment( int row, Qt::Alignment alignment );
@@ -133,6 +155,11 @@ private:
         Qt::SizeHint which, int row, qreal size,
         Qt::Orientation orientation );
 
+    void setStaticTracks( const QVector< qreal >&,
+        Qt::SizeMode, Qt::Orientation );
+
+    void adjustUnlimitedSpans();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -22,16 +22,11 @@ public:
     bool blockChildAdded : 1;
 
     /*
-       QGridLayoutEngine is supposed to find the alignment
-       ( see: QGridLayoutEngine::effectiveAlignment ) by looking up in:
-            item -> row/column -> layout default.
+       QskLayoutEngine finds the alignment by looking up in:
+            item -> row/column -> Qt::AlignLeft | Qt::AlignVCenter
 
-       Unfortunatly the layout default can't be modified without accessing
-       private methods and - for some reason worse - QGridLayoutEngine::effectiveAlignment
-       does not fall back to the layout default for the horizontal alignment.
-
-       But as we don't offer setting the row/column alignment at the public API
-       of QskIndexedLayoutBox we work around by using them instead.
+       As we don't offer setting the row/column alignment at the public API
+       of QskIndexedLayoutBox we use them for the layout default.
      */
     Qt::Alignment defaultAlignment;
 };
@@ -10,18 +10,72 @@
 #include "QskWindow.h"
 #include "QskEvent.h"
 
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QGlobalStatic>
+
 #include <limits>
 
+namespace
+{
+    /*
+        A pool of its own, so that the GUI thread never has to wait for
+        runnables queued by someone else on the global pool. As the
+        GUI thread calculates geometries too, we need one thread less.
+     */
+    class LayoutThreadPool final : public QThreadPool
+    {
+    public:
+        LayoutThreadPool()
+        {
+            setMaxThreadCount( qMax( QThread::idealThreadCount() - 1, 1 ) );
+        }
+    };
+
+    class LayoutRunnable final : public QRunnable
+    {
+    public:
+        LayoutRunnable( const QskLayoutEngine& engine,
+                const QRectF& rect, QSemaphore& semaphore ):
+            m_engine( engine ),
+            m_rect( rect ),
+            m_semaphore( semaphore )
+        {
+        }
+
+        virtual void run() override final
+        {
+            m_engine.calculateGeometries( m_rect );
+            m_semaphore.release();
+        }
+
+    private:
+        const QskLayoutEngine& m_engine;
+        const QRectF m_rect;
+        QSemaphore& m_semaphore;
+    };
+}
+
+Q_GLOBAL_STATIC( LayoutThreadPool, qskLayoutThreadPool )
+
 class QskLayout::PrivateData
 {
 public:
     PrivateData():
-        isActive( true )
+        isActive( true ),
+        hasPrecalculatedGeometries( false )
     {
     }
 
     bool isActive : 1;
 
+    // geometries have been set by the parent layout
+    bool hasPrecalculatedGeometries : 1;
+    QRectF precalculatedRect;
+
     QskLayoutEngine engine;
 };
 
@@ -43,6 +97,7 @@ void QskLayout::setActive( bool on )
         return;
 
     m_data->isActive = on;
+    m_data->hasPrecalculatedGeometries = false;
 
     for ( int i = 0; i < itemCount(); ++i )
     {
@@ -134,6 +189,7 @@ void QskLayout::insertItemInternal( QskLayoutItem* layoutItem, int index )
     }
 
     engine.insertLayoutItem( layoutItem, index );
+    m_data->hasPrecalculatedGeometries = false;
 
     if ( m_data->isActive )
     {
@@ -158,6 +214,7 @@ void QskLayout::removeAt( int index )
     layoutItemRemoved( layoutItem, index );
 
     delete layoutItem;
+    m_data->hasPrecalculatedGeometries = false;
 
     if ( m_data->isActive )
     {
@@ -202,6 +259,8 @@ void QskLayout::layoutItemRemoved( QskLayoutItem* layoutItem, int index )
 
 void QskLayout::activate()
 {
+    m_data->hasPrecalculatedGeometries = false;
+
     if ( m_data->isActive )
         polish();
 }
@@ -214,6 +273,32 @@ void QskLayout::invalidate()
     resetImplicitSize();
 }
 
+void QskLayout::invalidateItem( const QQuickItem* item )
+{
+    /*
+        Only the cached hints of this item and the aggregated
+        hints of its rows and columns have to be recalculated.
+     */
+    engine().invalidateItem( engine().layoutItemOf( item ) );
+    activate();
+
+    resetImplicitSize();
+}
+
+void QskLayout::invalidateSenderItem()
+{
+    invalidateItem( qobject_cast< const QQuickItem* >( sender() ) );
+}
+
+void QskLayout::updateSenderVisibility()
+{
+    // hidden items might be ignored by the engine
+    engine().invalidateItem( engine().layoutItemOf(
+        qobject_cast< const QQuickItem* >( sender() ) ) );
+
+    activate();
+}
+
 void QskLayout::adjustItem( const QQuickItem* item )
 {
     adjustItemAt( indexOf( item ) );
@@ -233,8 +318,103 @@ void QskLayout::adjustItemAt( int index )
 
 void QskLayout::updateLayout()
 {
-    if ( m_data->isActive )
-        engine().setGeometries( alignedLayoutRect( layoutRect() ) );
+    if ( !m_data->isActive )
+        return;
+
+    const QRectF rect = alignedLayoutRect( layoutRect() );
+
+    if ( !( m_data->hasPrecalculatedGeometries && rect == m_data->precalculatedRect ) )
+        engine().setGeometries( rect );
+
+    m_data->hasPrecalculatedGeometries = false;
+
+    if ( testControlFlag( QskControl::ConcurrentLayout ) )
+        layoutChildrenConcurrently();
+}
+
+void QskLayout::layoutChildrenConcurrently()
+{
+    /*
+        Once our items have their geometries, the child layouts are
+        independent from each other. The hints and the visibility of the
+        items are read in the GUI thread, then the geometries are calculated
+        on the thread pool and finally assigned in the GUI thread again.
+        The polish requests of the children are still pending, but they
+        find their geometries being up to date.
+
+        Layouts with items having a dynamic constraint are left to the
+        usual polishing, as heightForWidth/widthForHeight can't be
+        called outside of the GUI thread.
+     */
+
+    QVector< QskLayout* > layouts;
+    QVector< QRectF > rects;
+
+    const auto& engine = m_data->engine;
+
+    for ( int i = 0; i < engine.itemCount(); i++ )
+    {
+        auto layout = qobject_cast< QskLayout* >( engine.layoutItemAt( i )->item() );
+
+        if ( layout == nullptr || !layout->isActive() || !layout->isVisible() )
+            continue;
+
+        if ( !layout->m_data->engine.prefetchHints() )
+            continue;
+
+        layouts += layout;
+        rects += layout->alignedLayoutRect( layout->layoutRect() );
+    }
+
+    if ( layouts.count() < 2 )
+        return;
+
+    QSemaphore semaphore;
+
+    auto threadPool = qskLayoutThreadPool();
+
+    QVector< LayoutRunnable* > runnables;
+    runnables.reserve( layouts.count() - 1 );
+
+    for ( int i = 1; i < layouts.count(); i++ )
+    {
+        auto runnable = new LayoutRunnable(
+            layouts[ i ]->m_data->engine, rects[ i ], semaphore );
+
+        runnables += runnable;
+        threadPool->start( runnable );
+    }
+
+    // the GUI thread does not need to wait idle
+    layouts[ 0 ]->m_data->engine.calculateGeometries( rects[ 0 ] );
+
+#if QT_VERSION >= QT_VERSION_CHECK( 5, 9, 0 )
+    /*
+        Runnables, that have not been started yet, are taken back
+        and run in the GUI thread. So we only wait for the ones
+        being in progress.
+     */
+    for ( int i = runnables.count() - 1; i >= 0; i-- )
+    {
+        if ( threadPool->tryTake( runnables[ i ] ) )
+        {
+            runnables[ i ]->run();
+            delete runnables[ i ];
+        }
+    }
+#endif
+
+    semaphore.acquire( layouts.count() - 1 );
+
+    for ( int i = 0; i < layouts.count(); i++ )
+    {
+        auto d = layouts[ i ]->m_data.get();
+
+        d->engine.applyGeometries();
+
+        d->hasPrecalculatedGeometries = true;
+        d->precalculatedRect = rects[ i ];
+    }
 }
 
 QRectF QskLayout::alignedLayoutRect( const QRectF& rect ) const
@@ -255,7 +435,7 @@ void QskLayout::setItemActive( const QQuickItem* item, bool on )
     if ( item == nullptr )
         return;
 
-    // QskControl sends QEvent::LayoutRequest
+    // QskControl calls invalidateItem from layoutConstraintChanged
 
     const bool hasLayoutRequests = qobject_cast< const QskControl* >( item );
     if ( !hasLayoutRequests )
@@ -263,25 +443,31 @@ void QskLayout::setItemActive( const QQuickItem* item, bool on )
         if ( on )
         {
             connect( item, &QQuickItem::implicitWidthChanged,
-                this, &QskLayout::invalidate );
+                this, &QskLayout::invalidateSenderItem );
 
             connect( item, &QQuickItem::implicitHeightChanged,
-                this, &QskLayout::invalidate );
+                this, &QskLayout::invalidateSenderItem );
         }
         else
         {
             disconnect( item, &QQuickItem::implicitWidthChanged,
-                this, &QskLayout::invalidate );
+                this, &QskLayout::invalidateSenderItem );
 
             disconnect( item, &QQuickItem::implicitHeightChanged,
-                this, &QskLayout::invalidate );
+                this, &QskLayout::invalidateSenderItem );
         }
     }
 
     if ( on )
-        connect( item, &QQuickItem::visibleChanged, this, &QskLayout::activate );
+    {
+        connect( item, &QQuickItem::visibleChanged,
+            this, &QskLayout::updateSenderVisibility );
+    }
     else
-        disconnect( item, &QQuickItem::visibleChanged, this, &QskLayout::activate );
+    {
+        disconnect( item, &QQuickItem::visibleChanged,
+            this, &QskLayout::updateSenderVisibility );
+    }
 }
 
 QskLayoutEngine& QskLayout::engine()
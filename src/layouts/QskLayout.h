@@ -40,6 +40,9 @@ public:
     void adjustItem( const QQuickItem* );
     void adjustItemAt( int index );
 
+    // the hints of the item have changed
+    void invalidateItem( const QQuickItem* );
+
 public Q_SLOTS:
     void activate();
     void invalidate();
@@ -64,7 +67,13 @@ protected:
 
     virtual QRectF alignedLayoutRect( const QRectF& ) const;
 
+private Q_SLOTS:
+    void invalidateSenderItem();
+    void updateSenderVisibility();
+
 private:
+    void layoutChildrenConcurrently();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
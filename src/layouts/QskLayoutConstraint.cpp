@@ -9,6 +9,15 @@
 
 #include <limits>
 
+static int qskConstraintEvaluations = 0;
+static int qskConstraintCacheHits = 0;
+
+// not static as being used from QskLayoutItem.cpp
+void qskCountConstraintCacheHit()
+{
+    qskConstraintCacheHits++;
+}
+
 static inline qreal qskHintFor( const QQuickItem* item,
     const char* method, qreal widthOrHeight )
 {
@@ -56,6 +65,8 @@ bool QskLayoutConstraint::hasDynamicConstraint( const QQuickItem* item )
 
 qreal QskLayoutConstraint::heightForWidth( const QQuickItem* item, qreal width )
 {
+    qskConstraintEvaluations++;
+
     if ( const QskControl* control = qobject_cast< const QskControl* >( item ) )
         return control->heightForWidth( width );
 
@@ -64,6 +75,8 @@ qreal QskLayoutConstraint::heightForWidth( const QQuickItem* item, qreal width )
 
 qreal QskLayoutConstraint::widthForHeight( const QQuickItem* item, qreal height )
 {
+    qskConstraintEvaluations++;
+
     if ( const QskControl* control = qobject_cast< const QskControl* >( item ) )
         return control->widthForHeight( height );
 
@@ -145,3 +158,18 @@ QskSizePolicy QskLayoutConstraint::sizePolicy( const QQuickItem* item )
 }
 
 
+
+int QskLayoutConstraint::constraintEvaluations()
+{
+    return qskConstraintEvaluations;
+}
+
+int QskLayoutConstraint::constraintCacheHits()
+{
+    return qskConstraintCacheHits;
+}
+
+void QskLayoutConstraint::resetConstraintCounters()
+{
+    qskConstraintEvaluations = qskConstraintCacheHits = 0;
+}
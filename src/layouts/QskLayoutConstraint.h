@@ -23,7 +23,15 @@ namespace QskLayoutConstraint
     QSK_EXPORT QSizeF effectiveConstraint( const QQuickItem*, Qt::SizeHint );
     QSK_EXPORT QskSizePolicy sizePolicy( const QQuickItem* );
 
-    // QGridLayoutEngine internally uses FLT_MAX
+    /*
+        Statistics about the calls of heightForWidth/widthForHeight and
+        how many of them have been answered from the caches of the layouts.
+     */
+    QSK_EXPORT int constraintEvaluations();
+    QSK_EXPORT int constraintCacheHits();
+    QSK_EXPORT void resetConstraintCounters();
+
+    // using the float range to avoid overflows, when adding values
     const qreal unlimited = std::numeric_limits< float >::max();
 }
 
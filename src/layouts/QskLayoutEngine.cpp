@@ -5,135 +5,1387 @@
 
 #include "QskLayoutEngine.h"
 #include "QskLayoutItem.h"
-#include <QDebug>
+#include "QskLayoutConstraint.h"
 
-static inline bool qskIsColliding(
-    const QskLayoutEngine* engine, QskLayoutItem* item )
+#include <QVector>
+#include <QHash>
+#include <QtMath>
+
+#include <vector>
+#include <limits>
+
+template< typename T >
+static inline T qskValueAt( const std::vector< T >& values, int row, const T& defaultValue )
+{
+    if ( row >= 0 && row < static_cast< int >( values.size() ) )
+        return values[ row ];
+
+    return defaultValue;
+}
+
+template< typename T >
+static inline T& qskValueRef( std::vector< T >& values, int row, const T& defaultValue )
+{
+    if ( row >= static_cast< int >( values.size() ) )
+        values.resize( row + 1, defaultValue );
+
+    return values[ row ];
+}
+
+template< typename T >
+static inline void qskRemoveRows( std::vector< T >& values, int row, int count )
+{
+    const int size = static_cast< int >( values.size() );
+    if ( row < size )
+        values.erase( values.begin() + row, values.begin() + qMin( row + count, size ) );
+}
+
+namespace
 {
-    for ( int row = item->firstRow(); row <= item->lastRow(); row++ )
+    class Box
+    {
+    public:
+        inline Box( qreal min = 0.0, qreal pref = 0.0, qreal max = 0.0 ):
+            minimum( min ),
+            preferred( pref ),
+            maximum( max )
+        {
+        }
+
+        inline qreal value( Qt::SizeHint which ) const
+        {
+            switch( which )
+            {
+                case Qt::MinimumSize:
+                    return minimum;
+
+                case Qt::MaximumSize:
+                    return maximum;
+
+                default:
+                    return preferred;
+            }
+        }
+
+        inline void setValue( Qt::SizeHint which, qreal value )
+        {
+            switch( which )
+            {
+                case Qt::MinimumSize:
+                    minimum = value;
+                    break;
+
+                case Qt::MaximumSize:
+                    maximum = value;
+                    break;
+
+                default:
+                    preferred = value;
+            }
+        }
+
+        inline void unite( const Box& other )
+        {
+            minimum = qMax( minimum, other.minimum );
+            preferred = qMax( preferred, other.preferred );
+            maximum = qMax( maximum, other.maximum );
+        }
+
+        inline void normalize()
+        {
+            minimum = qMax( minimum, 0.0 );
+            maximum = qMax( maximum, minimum );
+            preferred = qBound( minimum, preferred, maximum );
+        }
+
+        qreal minimum;
+        qreal preferred;
+        qreal maximum;
+    };
+
+    class Row
+    {
+    public:
+        inline Row():
+            stretch( 0 ),
+            isActive( false ),
+            spacing( 0.0 ),
+            position( 0.0 ),
+            size( 0.0 )
+        {
+        }
+
+        Box box;
+        int stretch;
+        bool isActive;
+
+        qreal spacing; // to the following row
+        qreal position;
+        qreal size;
+    };
+
+    // settings of all rows or all columns
+
+    class Settings
+    {
+    public:
+        Settings():
+            count( 0 ),
+            spacing( QskLayoutEngine::defaultSpacing( Qt::Horizontal ) ),
+            trackMode( Qt::AbsoluteSize )
+        {
+        }
+
+        inline void expand( int rowCount )
+        {
+            count = qMax( count, rowCount );
+        }
+
+        void removeRows( int row, int numRows )
+        {
+            qskRemoveRows( spacings, row, numRows );
+            qskRemoveRows( stretches, row, numRows );
+            qskRemoveRows( alignments, row, numRows );
+            qskRemoveRows( hints, row, numRows );
+
+            if ( row < count )
+                count -= qMin( numRows, count - row );
+        }
+
+        inline Box hint( int row ) const
+        {
+            return qskValueAt( hints, row, defaultHint() );
+        }
+
+        static inline Box defaultHint()
+        {
+            return Box( 0.0, 0.0, QskLayoutConstraint::unlimited );
+        }
+
+        inline bool isStatic() const
+        {
+            return !tracks.empty();
+        }
+
+        int count;
+        qreal spacing;
+
+        std::vector< qreal > spacings;
+        std::vector< int > stretches;
+        std::vector< int > alignments;
+        std::vector< Box > hints;
+
+        std::vector< qreal > tracks;
+        Qt::SizeMode trackMode;
+    };
+}
+
+static qreal qskGrowRows( std::vector< Row >& rows,
+    qreal extra, bool stretchedOnly, bool bounded )
+{
+    /*
+        Distributing the extra space to the rows according to their weights.
+        Rows that reach their maximum are taken out and the remaining
+        space is distributed again to the others.
+     */
+
+    const auto canGrow = [=]( const Row& row ) -> bool
+    {
+        if ( !row.isActive || ( stretchedOnly && row.stretch <= 0 ) )
+            return false;
+
+        return !bounded || ( row.size < row.box.maximum );
+    };
+
+    while ( extra > 0.0 )
+    {
+        qreal sumWeights = 0.0;
+
+        for ( const auto& row : rows )
+        {
+            if ( canGrow( row ) )
+                sumWeights += stretchedOnly ? row.stretch : 1;
+        }
+
+        if ( sumWeights <= 0.0 )
+            break;
+
+        const qreal unit = extra / sumWeights;
+
+        bool isCapped = false;
+
+        for ( auto& row : rows )
+        {
+            if ( canGrow( row ) )
+            {
+                qreal delta = unit * ( stretchedOnly ? row.stretch : 1 );
+
+                if ( bounded && ( row.size + delta > row.box.maximum ) )
+                {
+                    delta = row.box.maximum - row.size;
+                    isCapped = true;
+                }
+
+                row.size += delta;
+                extra -= delta;
+            }
+        }
+
+        if ( !isCapped )
+            return 0.0;
+    }
+
+    return qMax( extra, 0.0 );
+}
+
+static inline quint64 qskCellKey( int row, int column )
+{
+    return ( quint64( quint32( row ) ) << 32 ) | quint32( column );
+}
+
+static inline int qskFirstChangedRow(
+    const std::vector< Row >& rows, const std::vector< Row >& oldRows )
+{
+    const size_t count = qMin( rows.size(), oldRows.size() );
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        if ( rows[ i ].position != oldRows[ i ].position
+            || rows[ i ].size != oldRows[ i ].size )
+        {
+            return static_cast< int >( i );
+        }
+    }
+
+    if ( rows.size() != oldRows.size() )
+        return static_cast< int >( count );
+
+    return std::numeric_limits< int >::max();
+}
+
+static inline qreal qskSpanExtent(
+    const std::vector< Row >& rows, int first, int last )
+{
+    const auto& r1 = rows[ first ];
+    const auto& r2 = rows[ last ];
+
+    return r2.position + r2.size - r1.position;
+}
+
+class QskLayoutEngine::PrivateData
+{
+public:
+    PrivateData():
+        visualDirection( Qt::LeftToRight ),
+        firstDirtyIndex( std::numeric_limits< int >::max() ),
+        lastDirtyIndex( -1 ),
+        hasCellIndex( false )
+    {
+        hasAggregates[ 0 ] = hasAggregates[ 1 ] = false;
+    }
+
+    inline Settings& settings( Qt::Orientation orientation )
+    {
+        return settingsData[ orientation == Qt::Vertical ];
+    }
+
+    inline const Settings& settings( Qt::Orientation orientation ) const
+    {
+        return settingsData[ orientation == Qt::Vertical ];
+    }
+
+    Qt::Orientations constrainedOrientation() const
+    {
+        if ( settingsData[ 0 ].isStatic() && settingsData[ 1 ].isStatic() )
+            return Qt::Orientations();
+
+        /*
+            Mixing items with height-for-width and width-for-height
+            constraints is not supported - the first one wins.
+         */
+        for ( const auto layoutItem : items )
+        {
+            if ( !layoutItem->isIgnored() && layoutItem->hasDynamicConstraint() )
+            {
+                const auto orientation = layoutItem->dynamicConstraintOrientation();
+
+                // static tracks do not depend on any constraint
+                if ( settings( orientation ).isStatic() )
+                    return Qt::Orientations();
+
+                return orientation;
+            }
+        }
+
+        return Qt::Orientations();
+    }
+
+    Box itemBox( const QskLayoutItem*, Qt::Orientation, qreal constraint ) const;
+    Qt::Alignment effectiveAlignment( const QskLayoutItem* ) const;
+
+    void setupRows( Qt::Orientation, bool isConstrained ) const;
+    void layoutRows( Qt::Orientation, qreal pos, qreal length ) const;
+
+    void setupStaticRows( Qt::Orientation ) const;
+    void layoutStaticRows( Qt::Orientation, qreal pos, qreal length ) const;
+    qreal totalHint( Qt::Orientation, Qt::SizeHint ) const;
+
+    void updateAggregates( Qt::Orientation, int count ) const;
+    void aggregateRow( Qt::Orientation, int row ) const;
+
+    void updateCellIndex() const;
+
+    void invalidateCells();
+    void invalidateRows( const QskLayoutItem* );
+
+    void updateIndexes( int from );
+
+    void markDirty( int from, int to ) const;
+    void markAllDirty() const;
+    void insertGeometry( int index );
+    void removeGeometry( int index );
+    void updateGeometries( const QRectF& ) const;
+
+    void updateIgnored();
+
+    QRectF geometryAt( int index, const QRectF& rect ) const;
+
+    QVector< QskLayoutItem* > items;
+    QHash< const QQuickItem*, QskLayoutItem* > layoutItems;
+
+    Settings settingsData[ 2 ];
+    Qt::LayoutDirection visualDirection;
+
+    // buffers being reused for all calculations
+
+    mutable std::vector< Row > rows[ 2 ];
+    mutable std::vector< Box > boxes[ 2 ];
+
+    // results of calculateGeometries()
+    mutable std::vector< QRectF > geometries;
+
+    /*
+        Only the items in the dirty range and the items in rows/columns,
+        that have been moved or resized, are calculated and assigned again.
+        All other items keep the geometries of the previous calculation.
+     */
+    mutable int firstDirtyIndex;
+    mutable int lastDirtyIndex;
+
+    mutable QRectF layoutRect;
+    mutable std::vector< Row > layoutRows[ 2 ];
+
+    // indexes of the geometries, that need to be applied, in increasing order
+    mutable std::vector< int > changedIndexes;
+
+    /*
+        The hints of the rows/columns aggregated from the items without
+        any constraint. When an item has been invalidated only its rows
+        are aggregated again, see invalidateRows().
+     */
+    mutable std::vector< Row > aggregatedRows[ 2 ];
+    mutable std::vector< std::vector< int > > rowItems[ 2 ]; // indexes of the items
+    mutable std::vector< int > dirtyRows[ 2 ];
+    mutable bool hasAggregates[ 2 ];
+
+    // cell -> index of the first item in this cell
+    mutable QHash< quint64, int > cellIndex;
+    mutable bool hasCellIndex;
+};
+
+void QskLayoutEngine::PrivateData::invalidateCells()
+{
+    hasCellIndex = false;
+    hasAggregates[ 0 ] = hasAggregates[ 1 ] = false;
+}
+
+void QskLayoutEngine::PrivateData::invalidateRows( const QskLayoutItem* layoutItem )
+{
+    for ( int o = 0; o < 2; o++ )
+    {
+        if ( !hasAggregates[ o ] )
+            continue;
+
+        const auto orientation = o ? Qt::Vertical : Qt::Horizontal;
+
+        const int count = static_cast< int >( aggregatedRows[ o ].size() );
+        const int last = qMin( layoutItem->lastRow( orientation ), count - 1 );
+
+        for ( int row = layoutItem->firstRow( orientation ); row <= last; row++ )
+            dirtyRows[ o ].push_back( row );
+    }
+}
+
+void QskLayoutEngine::PrivateData::updateIndexes( int from )
+{
+    for ( int i = from; i < items.count(); i++ )
+        items[ i ]->m_index = i;
+}
+
+void QskLayoutEngine::PrivateData::markDirty( int from, int to ) const
+{
+    firstDirtyIndex = qMin( firstDirtyIndex, from );
+    lastDirtyIndex = qMax( lastDirtyIndex, to );
+}
+
+void QskLayoutEngine::PrivateData::markAllDirty() const
+{
+    markDirty( 0, std::numeric_limits< int >::max() );
+}
+
+void QskLayoutEngine::PrivateData::insertGeometry( int index )
+{
+    // called after the item has been inserted
+
+    if ( !changedIndexes.empty() )
+    {
+        // the pending geometries are outdated and must not be applied
+        changedIndexes.clear();
+        geometries.clear();
+    }
+
+    if ( static_cast< int >( geometries.size() ) == items.count() - 1 )
+        geometries.insert( geometries.begin() + index, QRectF() );
+
+    const int maxIndex = std::numeric_limits< int >::max();
+
+    if ( firstDirtyIndex >= index && firstDirtyIndex < maxIndex )
+        firstDirtyIndex++;
+
+    if ( lastDirtyIndex >= index && lastDirtyIndex < maxIndex )
+        lastDirtyIndex++;
+
+    markDirty( index, index );
+}
+
+void QskLayoutEngine::PrivateData::removeGeometry( int index )
+{
+    // called after the item has been removed
+
+    if ( !changedIndexes.empty() )
+    {
+        changedIndexes.clear();
+        geometries.clear();
+    }
+
+    if ( static_cast< int >( geometries.size() ) == items.count() + 1 )
+        geometries.erase( geometries.begin() + index );
+
+    const int maxIndex = std::numeric_limits< int >::max();
+
+    if ( firstDirtyIndex > index && firstDirtyIndex < maxIndex )
+        firstDirtyIndex--;
+
+    if ( lastDirtyIndex >= index && lastDirtyIndex < maxIndex )
+        lastDirtyIndex--;
+}
+
+void QskLayoutEngine::PrivateData::updateGeometries( const QRectF& rect ) const
+{
+    const int count = items.count();
+
+    // geometries of a previous calculation, that have not been applied
+    for ( const auto index : changedIndexes )
+        markDirty( index, index );
+
+    changedIndexes.clear();
+
+    if ( rect != layoutRect || static_cast< int >( geometries.size() ) != count )
+    {
+        geometries.resize( count );
+        markAllDirty();
+    }
+
+    /*
+        When a row or column has been moved or resized, all items
+        from there on might be affected. For a linear box, where an item
+        has been appended, these are the new row and its item only.
+     */
+
+    int firstChangedRows[ 2 ];
+
+    for ( int o = 0; o < 2; o++ )
+    {
+        firstChangedRows[ o ] = qskFirstChangedRow( rows[ o ], layoutRows[ o ] );
+        layoutRows[ o ] = rows[ o ];
+    }
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto layoutItem = items[ i ];
+
+        const bool isDirty = ( i >= firstDirtyIndex && i <= lastDirtyIndex )
+            || ( layoutItem->lastColumn() >= firstChangedRows[ 0 ] )
+            || ( layoutItem->lastRow() >= firstChangedRows[ 1 ] );
+
+        if ( isDirty )
+        {
+            geometries[ i ] = geometryAt( i, rect );
+            changedIndexes.push_back( i );
+        }
+    }
+
+    layoutRect = rect;
+
+    firstDirtyIndex = std::numeric_limits< int >::max();
+    lastDirtyIndex = -1;
+}
+
+void QskLayoutEngine::PrivateData::updateIgnored()
+{
+    // reading the visibility of the items, what needs to be done in the GUI thread
+
+    for ( int i = 0; i < items.count(); i++ )
+    {
+        const auto layoutItem = items[ i ];
+
+        if ( layoutItem->updateIgnored() )
+        {
+            invalidateRows( layoutItem );
+            markDirty( i, i );
+        }
+    }
+}
+
+void QskLayoutEngine::PrivateData::updateAggregates(
+    Qt::Orientation orientation, int count ) const
+{
+    const int o = ( orientation == Qt::Vertical );
+
+    auto& aggregates = aggregatedRows[ o ];
+
+    if ( hasAggregates[ o ] && static_cast< int >( aggregates.size() ) == count )
+    {
+        for ( const auto row : dirtyRows[ o ] )
+            aggregateRow( orientation, row );
+    }
+    else
+    {
+        aggregates.assign( count, Row() );
+
+        auto& itemsOfRows = rowItems[ o ];
+        itemsOfRows.assign( count, std::vector< int >() );
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            const auto layoutItem = items[ i ];
+
+            const int last = layoutItem->lastRow( orientation );
+            for ( int row = layoutItem->firstRow( orientation ); row <= last; row++ )
+                itemsOfRows[ row ].push_back( i );
+        }
+
+        for ( int row = 0; row < count; row++ )
+            aggregateRow( orientation, row );
+
+        hasAggregates[ o ] = true;
+    }
+
+    dirtyRows[ o ].clear();
+}
+
+void QskLayoutEngine::PrivateData::aggregateRow(
+    Qt::Orientation orientation, int row ) const
+{
+    const int o = ( orientation == Qt::Vertical );
+
+    Row r;
+
+    for ( const auto index : rowItems[ o ][ row ] )
+    {
+        const auto layoutItem = items[ index ];
+
+        if ( layoutItem->isIgnored() )
+            continue;
+
+        r.isActive = true;
+
+        const int stretch = layoutItem->stretchFactor( orientation );
+        if ( stretch > 0 )
+            r.stretch = qMax( r.stretch, stretch );
+
+        // items spanning several rows are distributed later
+        if ( layoutItem->rowSpan( orientation ) == 1 )
+            r.box.unite( itemBox( layoutItem, orientation, -1.0 ) );
+    }
+
+    aggregatedRows[ o ][ row ] = r;
+}
+
+void QskLayoutEngine::PrivateData::updateCellIndex() const
+{
+    cellIndex.clear();
+
+    // running backwards, so that the first item of a cell wins
+    for ( int i = items.size() - 1; i >= 0; i-- )
+    {
+        const auto layoutItem = items[ i ];
+
+        for ( int row = layoutItem->firstRow(); row <= layoutItem->lastRow(); row++ )
+        {
+            for ( int col = layoutItem->firstColumn(); col <= layoutItem->lastColumn(); col++ )
+                cellIndex.insert( qskCellKey( row, col ), i );
+        }
+    }
+
+    hasCellIndex = true;
+}
+
+Box QskLayoutEngine::PrivateData::itemBox( const QskLayoutItem* layoutItem,
+    Qt::Orientation orientation, qreal constraint ) const
+{
+    const QSizeF minimum = layoutItem->effectiveSizeHint( Qt::MinimumSize );
+    const QSizeF preferred = layoutItem->effectiveSizeHint( Qt::PreferredSize );
+    const QSizeF maximum = layoutItem->effectiveSizeHint( Qt::MaximumSize );
+
+    Box box;
+
+    if ( orientation == Qt::Horizontal )
+        box = Box( minimum.width(), preferred.width(), maximum.width() );
+    else
+        box = Box( minimum.height(), preferred.height(), maximum.height() );
+
+    if ( constraint >= 0.0 && layoutItem->hasDynamicConstraint()
+        && layoutItem->dynamicConstraintOrientation() == orientation )
+    {
+        QSizeF size( -1.0, -1.0 );
+        if ( orientation == Qt::Vertical )
+            size.setWidth( constraint );
+        else
+            size.setHeight( constraint );
+
+        const QSizeF hint = layoutItem->sizeHint( Qt::PreferredSize, size );
+        const auto policy = layoutItem->sizePolicy( orientation );
+
+        box.preferred = ( orientation == Qt::Vertical ) ? hint.height() : hint.width();
+
+        if ( !( policy & QskSizePolicy::ShrinkFlag ) )
+            box.minimum = qCeil( box.preferred );
+
+        if ( !( policy & ( QskSizePolicy::GrowFlag | QskSizePolicy::ExpandFlag ) ) )
+            box.maximum = box.preferred;
+
+        if ( policy & QskSizePolicy::IgnoreFlag )
+            box.preferred = box.minimum;
+
+        box.normalize();
+    }
+
+    return box;
+}
+
+Qt::Alignment QskLayoutEngine::PrivateData::effectiveAlignment(
+    const QskLayoutItem* layoutItem ) const
+{
+    Qt::Alignment alignment = layoutItem->alignment();
+
+    if ( !( alignment & Qt::AlignVertical_Mask ) )
+    {
+        const auto& settings = settingsData[ 1 ];
+
+        const auto rowAlignment = static_cast< Qt::Alignment >(
+            qskValueAt( settings.alignments, layoutItem->firstRow(), 0 ) );
+
+        if ( rowAlignment & Qt::AlignVertical_Mask )
+            alignment |= rowAlignment & Qt::AlignVertical_Mask;
+        else
+            alignment |= Qt::AlignVCenter;
+    }
+
+    if ( !( alignment & Qt::AlignHorizontal_Mask ) )
+    {
+        const auto& settings = settingsData[ 0 ];
+
+        const auto columnAlignment = static_cast< Qt::Alignment >(
+            qskValueAt( settings.alignments, layoutItem->firstColumn(), 0 ) );
+
+        alignment |= columnAlignment & Qt::AlignHorizontal_Mask;
+    }
+
+    return alignment;
+}
+
+void QskLayoutEngine::PrivateData::setupRows(
+    Qt::Orientation orientation, bool isConstrained ) const
+{
+    /*
+        When being constrained, the rows of the other orientation have
+        already been calculated and the extents of the cells are used
+        as constraint for the items with a dynamic constraint.
+     */
+
+    const int o = ( orientation == Qt::Vertical );
+    const Qt::Orientation otherOrientation =
+        ( orientation == Qt::Vertical ) ? Qt::Horizontal : Qt::Vertical;
+
+    const auto& settings = settingsData[ o ];
+
+    if ( settings.isStatic() )
+    {
+        setupStaticRows( orientation );
+        return;
+    }
+
+    int count = settings.count;
+    for ( const auto layoutItem : items )
+        count = qMax( count, layoutItem->lastRow( orientation ) + 1 );
+
+    auto& rows = this->rows[ o ];
+
+    auto& boxes = this->boxes[ o ];
+    boxes.resize( items.size() );
+
+    const auto& otherRows = this->rows[ 1 - o ];
+    const auto& otherBoxes = this->boxes[ 1 - o ];
+
+    bool hasSpans = false;
+
+    if ( isConstrained )
+    {
+        rows.assign( count, Row() );
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            const auto layoutItem = items[ i ];
+
+            qreal constraint = -1.0;
+
+            if ( layoutItem->hasDynamicConstraint()
+                && layoutItem->dynamicConstraintOrientation() == orientation )
+            {
+                constraint = qskSpanExtent( otherRows,
+                    layoutItem->firstRow( otherOrientation ),
+                    layoutItem->lastRow( otherOrientation ) );
+
+                constraint = qMin( constraint, otherBoxes[ i ].maximum );
+            }
+
+            const Box box = itemBox( layoutItem, orientation, constraint );
+            boxes[ i ] = box;
+
+            if ( layoutItem->isIgnored() )
+                continue;
+
+            const int first = layoutItem->firstRow( orientation );
+            const int last = layoutItem->lastRow( orientation );
+            const int stretch = layoutItem->stretchFactor( orientation );
+
+            for ( int row = first; row <= last; row++ )
+            {
+                auto& r = rows[ row ];
+
+                r.isActive = true;
+                if ( stretch > 0 )
+                    r.stretch = qMax( r.stretch, stretch );
+            }
+
+            if ( first == last )
+                rows[ first ].box.unite( box );
+            else
+                hasSpans = true;
+        }
+    }
+    else
+    {
+        // without a constraint the aggregated hints of the rows can be used
+        updateAggregates( orientation, count );
+        rows = aggregatedRows[ o ];
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            const auto layoutItem = items[ i ];
+
+            boxes[ i ] = itemBox( layoutItem, orientation, -1.0 );
+
+            if ( !layoutItem->isIgnored() && layoutItem->rowSpan( orientation ) > 1 )
+                hasSpans = true;
+        }
+    }
+
+    for ( int row = 0; row < count; row++ )
+    {
+        auto& r = rows[ row ];
+
+        r.spacing = qskValueAt( settings.spacings, row, -1.0 );
+        if ( r.spacing < 0.0 )
+            r.spacing = settings.spacing;
+
+        const int stretch = qskValueAt( settings.stretches, row, -1 );
+        if ( stretch >= 0 )
+            r.stretch = stretch;
+
+        r.box.normalize();
+    }
+
+    if ( hasSpans )
+    {
+        /*
+            Items spanning several rows might need more space than
+            the rows offer. The missing space is distributed according
+            to the stretch factors or equally, when having none.
+         */
+
+        const Qt::SizeHint hints[] =
+            { Qt::MinimumSize, Qt::PreferredSize, Qt::MaximumSize };
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            const auto layoutItem = items[ i ];
+
+            const int first = layoutItem->firstRow( orientation );
+            const int last = layoutItem->lastRow( orientation );
+
+            if ( first == last || layoutItem->isIgnored() )
+                continue;
+
+            for ( const auto which : hints )
+            {
+                qreal extent = 0.0;
+                int sumStretches = 0;
+
+                for ( int row = first; row <= last; row++ )
+                {
+                    const auto& r = rows[ row ];
+
+                    extent += r.box.value( which );
+                    if ( row < last )
+                        extent += r.spacing;
+
+                    sumStretches += r.stretch;
+                }
+
+                const qreal delta = boxes[ i ].value( which ) - extent;
+                if ( delta <= 0.0 )
+                    continue;
+
+                for ( int row = first; row <= last; row++ )
+                {
+                    auto& r = rows[ row ];
+
+                    const qreal factor = ( sumStretches > 0 )
+                        ? qreal( r.stretch ) / sumStretches : 1.0 / ( last - first + 1 );
+
+                    r.box.setValue( which, r.box.value( which ) + factor * delta );
+                }
+            }
+
+            for ( int row = first; row <= last; row++ )
+                rows[ row ].box.normalize();
+        }
+    }
+
+    for ( int row = 0; row < static_cast< int >( settings.hints.size() ); row++ )
+    {
+        if ( row >= count )
+            break;
+
+        const Box& hint = settings.hints[ row ];
+        auto& r = rows[ row ];
+
+        r.box.minimum = qMax( r.box.minimum, hint.minimum );
+        r.box.preferred = qMax( r.box.preferred, hint.preferred );
+        r.box.maximum = qMax( r.box.minimum, qMin( r.box.maximum, hint.maximum ) );
+        r.box.normalize();
+
+        if ( hint.minimum > 0.0 || hint.preferred > 0.0 )
+            r.isActive = true;
+    }
+}
+
+void QskLayoutEngine::PrivateData::layoutRows(
+    Qt::Orientation orientation, qreal pos, qreal length ) const
+{
+    if ( settings( orientation ).isStatic() )
+    {
+        layoutStaticRows( orientation, pos, length );
+        return;
+    }
+
+    auto& rows = this->rows[ orientation == Qt::Vertical ];
+
+    qreal sumMinimum = 0.0;
+    qreal sumPreferred = 0.0;
+    qreal sumSpacing = 0.0;
+
+    bool hasStretches = false;
+    const Row* lastRow = nullptr;
+
+    for ( const auto& row : rows )
+    {
+        if ( !row.isActive )
+            continue;
+
+        if ( lastRow )
+            sumSpacing += lastRow->spacing;
+
+        sumMinimum += row.box.minimum;
+        sumPreferred += row.box.preferred;
+
+        if ( row.stretch > 0 )
+            hasStretches = true;
+
+        lastRow = &row;
+    }
+
+    const qreal available = length - sumSpacing;
+
+    if ( available < sumPreferred )
     {
-        for ( int col = item->firstColumn(); col <= item->lastColumn(); col++ )
+        if ( available > sumMinimum )
+        {
+            const qreal f = ( available - sumMinimum ) / ( sumPreferred - sumMinimum );
+
+            for ( auto& row : rows )
+                row.size = row.box.minimum + f * ( row.box.preferred - row.box.minimum );
+        }
+        else
         {
-            if ( engine->itemAt(row, col) )
-                return true;
+            // not enough space, even for the minimum sizes
+
+            const qreal f = ( sumMinimum > 0.0 ) ? qMax( available, 0.0 ) / sumMinimum : 0.0;
+
+            for ( auto& row : rows )
+                row.size = f * row.box.minimum;
         }
     }
+    else
+    {
+        for ( auto& row : rows )
+            row.size = row.box.preferred;
+
+        qreal extra = available - sumPreferred;
+
+        if ( hasStretches )
+            extra = qskGrowRows( rows, extra, true, true );
+
+        extra = qskGrowRows( rows, extra, false, true );
+
+        // what is left goes to the cells, not to the items
+        qskGrowRows( rows, extra, hasStretches, false );
+    }
+
+    qreal p = pos;
+
+    for ( auto& row : rows )
+    {
+        row.position = p;
 
-    return false;
+        if ( row.isActive )
+            p += row.size + row.spacing;
+        else
+            row.size = 0.0;
+    }
 }
 
-namespace
+void QskLayoutEngine::PrivateData::setupStaticRows( Qt::Orientation orientation ) const
 {
-    class MessageHandler
+    /*
+        The tracks are known in advance and we only need to make
+        sure, that items outside of them do not access invalid rows.
+        None of the hints of the items are involved.
+     */
+
+    const int o = ( orientation == Qt::Vertical );
+    const auto& settings = settingsData[ o ];
+
+    const int numTracks = static_cast< int >( settings.tracks.size() );
+
+    int count = numTracks;
+    for ( const auto layoutItem : items )
+        count = qMax( count, layoutItem->lastRow( orientation ) + 1 );
+
+    auto& rows = this->rows[ o ];
+    rows.assign( count, Row() );
+
+    for ( int row = 0; row < numTracks; row++ )
     {
-    public:
-        MessageHandler()
-        {
-            m_defaultHandler = qInstallMessageHandler( suppressWarning );
-        }
+        auto& r = rows[ row ];
+
+        const qreal size = qMax( settings.tracks[ row ], 0.0 );
+
+        if ( settings.trackMode == Qt::AbsoluteSize )
+            r.box = Box( size, size, size );
+        else
+            r.box = Box( 0.0, 0.0, QskLayoutConstraint::unlimited );
 
-        ~MessageHandler()
+        r.isActive = true;
+
+        if ( row < numTracks - 1 )
         {
-            qInstallMessageHandler( m_defaultHandler );
+            r.spacing = qskValueAt( settings.spacings, row, -1.0 );
+            if ( r.spacing < 0.0 )
+                r.spacing = settings.spacing;
         }
+    }
 
-    private:
-        static void suppressWarning( QtMsgType type,
-            const QMessageLogContext& context, const QString& message )
-        {
-            if ( type == QtWarningMsg )
-                return;
+    auto& boxes = this->boxes[ o ];
+    boxes.assign( items.size(), Box( 0.0, 0.0, QskLayoutConstraint::unlimited ) );
+}
 
-            if ( m_defaultHandler )
-                ( *m_defaultHandler )( type, context, message );
-        }
+void QskLayoutEngine::PrivateData::layoutStaticRows(
+    Qt::Orientation orientation, qreal pos, qreal length ) const
+{
+    const int o = ( orientation == Qt::Vertical );
+    const auto& settings = settingsData[ o ];
 
-        static QtMessageHandler m_defaultHandler;
-    };
+    auto& rows = this->rows[ o ];
 
-    QtMessageHandler MessageHandler::m_defaultHandler;
+    qreal factor = 1.0;
 
-    class LayoutStyleInfo final : public QAbstractLayoutStyleInfo
+    if ( settings.trackMode == Qt::RelativeSize )
     {
-    public:
-        LayoutStyleInfo()
-        {
-        }
+        qreal sumFractions = 0.0;
+        qreal sumSpacing = 0.0;
 
-        virtual qreal spacing( Qt::Orientation ) const override
+        for ( const auto& row : rows )
         {
-            // later from the theme !!
-            return 5.0;
+            if ( row.isActive )
+                sumSpacing += row.spacing;
         }
 
-        virtual qreal windowMargin( Qt::Orientation ) const override
+        for ( const auto track : settings.tracks )
+            sumFractions += qMax( track, 0.0 );
+
+        if ( sumFractions > 0.0 )
+            factor = qMax( length - sumSpacing, 0.0 ) / sumFractions;
+    }
+
+    qreal p = pos;
+
+    for ( int row = 0; row < static_cast< int >( rows.size() ); row++ )
+    {
+        auto& r = rows[ row ];
+
+        r.position = p;
+
+        if ( r.isActive )
         {
-            // later from the theme !!
-            return 0;
-        }
+            r.size = qMax( settings.tracks[ row ], 0.0 );
+            if ( settings.trackMode == Qt::RelativeSize )
+                r.size *= factor;
 
-        virtual bool hasChangedCore() const override
+            p += r.size + r.spacing;
+        }
+        else
         {
-            return false; // never changes
+            // items outside of the tracks end up with an empty geometry
+            r.size = 0.0;
         }
-    };
+    }
+}
+
+qreal QskLayoutEngine::PrivateData::totalHint(
+    Qt::Orientation orientation, Qt::SizeHint which ) const
+{
+    const auto& rows = this->rows[ orientation == Qt::Vertical ];
+
+    qreal total = 0.0;
+    const Row* lastRow = nullptr;
+
+    for ( const auto& row : rows )
+    {
+        if ( !row.isActive )
+            continue;
+
+        if ( lastRow )
+            total += lastRow->spacing;
+
+        total += row.box.value( which );
+        lastRow = &row;
+    }
+
+    return qMin( total, qreal( QskLayoutConstraint::unlimited ) );
+}
+
+QRectF QskLayoutEngine::PrivateData::geometryAt( int index, const QRectF& rect ) const
+{
+    const auto layoutItem = items[ index ];
+
+    const auto& columns = this->rows[ 0 ];
+    const auto& rows = this->rows[ 1 ];
+
+    const QRectF cell(
+        columns[ layoutItem->firstColumn() ].position,
+        rows[ layoutItem->firstRow() ].position,
+        qskSpanExtent( columns, layoutItem->firstColumn(), layoutItem->lastColumn() ),
+        qskSpanExtent( rows, layoutItem->firstRow(), layoutItem->lastRow() ) );
+
+    const qreal w = qMin( boxes[ 0 ][ index ].maximum, cell.width() );
+    const qreal h = qMin( boxes[ 1 ][ index ].maximum, cell.height() );
+
+    const Qt::Alignment alignment = effectiveAlignment( layoutItem );
+
+    qreal x = cell.x();
+    qreal y = cell.y();
+
+    if ( alignment & Qt::AlignRight )
+        x += cell.width() - w;
+    else if ( alignment & Qt::AlignHCenter )
+        x += 0.5 * ( cell.width() - w );
+
+    if ( alignment & Qt::AlignBottom )
+        y += cell.height() - h;
+    else if ( alignment & Qt::AlignVCenter )
+        y += 0.5 * ( cell.height() - h );
+
+    if ( visualDirection == Qt::RightToLeft )
+        x = rect.left() + rect.right() - ( x + w );
+
+    // snapping to the pixel grid
+
+    const qreal left = qRound( x );
+    const qreal top = qRound( y );
+    const qreal right = qRound( x + w );
+    const qreal bottom = qRound( y + h );
+
+    return QRectF( left, top, right - left, bottom - top );
 }
 
 QskLayoutEngine::QskLayoutEngine():
-    QGridLayoutEngine( Qt::AlignVCenter, true /*snapToPixelGrid*/ )
+    m_data( new PrivateData() )
 {
 }
 
 QskLayoutEngine::~QskLayoutEngine()
 {
+    qDeleteAll( m_data->items );
 }
 
 void QskLayoutEngine::setGeometries( const QRectF rect )
 {
-    const LayoutStyleInfo styleInfo;
-    QGridLayoutEngine::setGeometries( rect, &styleInfo );
+    m_data->updateIgnored();
+
+    calculateGeometries( rect );
+    applyGeometries();
 }
 
-void QskLayoutEngine::insertLayoutItem( QskLayoutItem* item, int index )
+bool QskLayoutEngine::prefetchHints() const
+{
+    /*
+        Filling the caches of the layout items, so that the calculation
+        only works on values, that have been read before. Items with
+        a dynamic constraint have to be asked for heightForWidth/widthForHeight
+        during the calculation, what can't be done outside of the GUI thread.
+     */
+
+    m_data->updateIgnored();
+
+    bool isIndependent = true;
+
+    for ( const auto layoutItem : m_data->items )
+    {
+        // boxes are calculated for ignored items too
+        ( void ) layoutItem->effectiveSizeHint( Qt::MinimumSize );
+
+        if ( !layoutItem->isIgnored() && layoutItem->hasDynamicConstraint() )
+        {
+            const auto orientation = layoutItem->dynamicConstraintOrientation();
+            if ( !m_data->settings( orientation ).isStatic() )
+                isIndependent = false;
+        }
+    }
+
+    return isIndependent;
+}
+
+void QskLayoutEngine::calculateGeometries( const QRectF& rect ) const
+{
+    if ( m_data->items.isEmpty() )
+    {
+        m_data->geometries.clear();
+        m_data->changedIndexes.clear();
+
+        return;
+    }
+
+    /*
+        The orientation, that depends on the other one,
+        has to be calculated last.
+     */
+
+    const auto constrained = m_data->constrainedOrientation();
+
+    const auto orientation1 =
+        ( constrained == Qt::Horizontal ) ? Qt::Vertical : Qt::Horizontal;
+
+    const auto orientation2 =
+        ( orientation1 == Qt::Horizontal ) ? Qt::Vertical : Qt::Horizontal;
+
+    const auto pos = [ &rect ]( Qt::Orientation orientation )
+        { return ( orientation == Qt::Horizontal ) ? rect.x() : rect.y(); };
+
+    const auto length = [ &rect ]( Qt::Orientation orientation )
+        { return ( orientation == Qt::Horizontal ) ? rect.width() : rect.height(); };
+
+    m_data->setupRows( orientation1, false );
+    m_data->layoutRows( orientation1, pos( orientation1 ), length( orientation1 ) );
+
+    m_data->setupRows( orientation2, constrained != 0 );
+    m_data->layoutRows( orientation2, pos( orientation2 ), length( orientation2 ) );
+
+    m_data->updateGeometries( rect );
+}
+
+void QskLayoutEngine::applyGeometries()
+{
+    const auto& items = m_data->items;
+    const auto& geometries = m_data->geometries;
+
+    auto& changedIndexes = m_data->changedIndexes;
+
+    // items might have been removed in between
+    if ( static_cast< int >( geometries.size() ) != items.size() )
+    {
+        changedIndexes.clear();
+        m_data->markAllDirty();
+
+        return;
+    }
+
+    size_t next = 0;
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const auto layoutItem = items[ i ];
+
+        const bool isChanged = ( next < changedIndexes.size() )
+            && ( changedIndexes[ next ] == i );
+
+        if ( isChanged )
+            next++;
+
+        /*
+            Unchanged geometries are assigned again, when the item
+            has been moved from somewhere else - f.e by the animators
+            of QskStackBox - or when they could not be assigned before
+            because of the update mode.
+         */
+        if ( isChanged || !layoutItem->hasGeometry( geometries[ i ] ) )
+            layoutItem->setGeometry( geometries[ i ] );
+    }
+
+    changedIndexes.clear();
+}
+
+void QskLayoutEngine::invalidate()
+{
+    for ( const auto layoutItem : m_data->items )
+        layoutItem->invalidate();
+
+    m_data->invalidateCells();
+    m_data->markAllDirty();
+}
+
+void QskLayoutEngine::invalidateItem( QskLayoutItem* layoutItem )
 {
-    if ( qskIsColliding( this, item ) )
+    if ( layoutItem )
     {
-        // It is totally valid to have more than one item in the same cell
-        // and we make use of it f.e in QskStackLayout. So we better
-        // suppress the corresponding warning to avoid confusion.
+        layoutItem->invalidate();
+        layoutItem->updateIgnored();
 
-        MessageHandler suppressWarning;
-        insertItem( item, index );
+        m_data->invalidateRows( layoutItem );
+        m_data->markDirty( layoutItem->m_index, layoutItem->m_index );
     }
+}
+
+void QskLayoutEngine::itemChanged( const QskLayoutItem* layoutItem, bool cellsChanged )
+{
+    if ( cellsChanged )
+        m_data->invalidateCells();
     else
+        m_data->invalidateRows( layoutItem );
+
+    m_data->markDirty( layoutItem->m_index, layoutItem->m_index );
+}
+
+void QskLayoutEngine::setVisualDirection( Qt::LayoutDirection direction )
+{
+    if ( direction != m_data->visualDirection )
     {
-        insertItem( item, index );
+        m_data->visualDirection = direction;
+        m_data->markAllDirty();
     }
 }
 
+Qt::LayoutDirection QskLayoutEngine::visualDirection() const
+{
+    return m_data->visualDirection;
+}
+
+int QskLayoutEngine::itemCount() const
+{
+    return m_data->items.count();
+}
+
+void QskLayoutEngine::insertLayoutItem( QskLayoutItem* item, int index )
+{
+    // It is totally valid to have more than one item in the same cell
+    // and we make use of it f.e in QskStackLayout.
+
+    auto& items = m_data->items;
+
+    if ( index < 0 || index > items.count() )
+        index = items.count();
+
+    items.insert( index, item );
+
+    if ( item->item() )
+        m_data->layoutItems.insert( item->item(), item );
+
+    item->m_engine = this;
+    item->updateIgnored();
+
+    m_data->updateIndexes( index );
+    m_data->insertGeometry( index );
+
+    m_data->settings( Qt::Horizontal ).expand( item->lastColumn() + 1 );
+    m_data->settings( Qt::Vertical ).expand( item->lastRow() + 1 );
+
+    m_data->invalidateCells();
+}
+
+void QskLayoutEngine::removeItem( QskLayoutItem* item )
+{
+    if ( item == nullptr || item->m_engine != this )
+        return;
+
+    const int index = item->m_index;
+    m_data->items.remove( index );
+
+    if ( item->item() )
+        m_data->layoutItems.remove( item->item() );
+
+    item->m_engine = nullptr;
+    item->m_index = -1;
+
+    m_data->updateIndexes( index );
+    m_data->removeGeometry( index );
+
+    m_data->invalidateCells();
+}
+
 int QskLayoutEngine::indexAt( int row, int column ) const
 {
-    const auto item = layoutItemAt( row, column );
-    if ( item )
-        return q_items.indexOf( item );
+    if ( row < 0 || row >= rowCount() || column < 0 || column >= columnCount() )
+        return -1;
+
+    if ( !m_data->hasCellIndex )
+        m_data->updateCellIndex();
 
-    return -1;
+    return m_data->cellIndex.value( qskCellKey( row, column ), -1 );
 }
 
 QskLayoutItem* QskLayoutEngine::layoutItemAt( int index ) const
 {
-    if ( index < 0 || index >= q_items.count() )
+    if ( index < 0 || index >= m_data->items.count() )
         return nullptr;
 
-    return static_cast< QskLayoutItem* >( q_items[index] );
+    return m_data->items[ index ];
 }
 
 QskLayoutItem* QskLayoutEngine::layoutItemAt( int row, int column ) const
 {
-    if ( row < 0 || row >= rowCount() || column < 0 || column >= columnCount() )
-        return nullptr;
-
-    return static_cast< QskLayoutItem* >( itemAt( row, column ) );
+    return layoutItemAt( indexAt( row, column ) );
 }
 
 QskLayoutItem* QskLayoutEngine::layoutItemAt(
@@ -145,42 +1397,230 @@ QskLayoutItem* QskLayoutEngine::layoutItemAt(
         return layoutItemAt( column, row );
 }
 
+QskLayoutItem* QskLayoutEngine::layoutItemOf( const QQuickItem* item ) const
+{
+    return m_data->layoutItems.value( item, nullptr );
+}
+
 int QskLayoutEngine::indexOf( const QQuickItem* item ) const
 {
-    // linear search might become slow for many items,
-    // better introduce some sort of hash table TODO ...
+    const auto layoutItem = layoutItemOf( item );
+    return layoutItem ? layoutItem->m_index : -1;
+}
+
+int QskLayoutEngine::rowCount( Qt::Orientation orientation ) const
+{
+    return m_data->settings( orientation ).count;
+}
+
+int QskLayoutEngine::effectiveLastRow( Qt::Orientation orientation ) const
+{
+    int lastRow = -1;
+
+    for ( const auto layoutItem : m_data->items )
+        lastRow = qMax( lastRow, layoutItem->lastRow( orientation ) );
+
+    return lastRow;
+}
+
+void QskLayoutEngine::removeRows( int row, int count, Qt::Orientation orientation )
+{
+    if ( row < 0 || count <= 0 )
+        return;
 
-    for ( int i = q_items.count() - 1; i >= 0; --i )
+    m_data->settings( orientation ).removeRows( row, count );
+    m_data->invalidateCells();
+
+    for ( const auto layoutItem : m_data->items )
     {
-        const auto layoutItem = static_cast< const QskLayoutItem* >( q_items[i] );
-        if ( layoutItem->item() == item )
-            return i;
-    }
+        const int firstRow = layoutItem->firstRow( orientation );
 
-    return -1;
+        if ( firstRow >= row )
+        {
+            layoutItem->setFirstRow( firstRow - count, orientation );
+        }
+        else if ( layoutItem->lastRow( orientation ) >= row )
+        {
+            layoutItem->setRowSpan(
+                layoutItem->rowSpan( orientation ) - count, orientation );
+        }
+    }
 }
 
 QSizeF QskLayoutEngine::sizeHint( Qt::SizeHint which, const QSizeF& constraint ) const
 {
-    const LayoutStyleInfo styleInfo;
-    return QGridLayoutEngine::sizeHint( which, constraint, &styleInfo );
+    if ( which < Qt::MinimumSize || which > Qt::MaximumSize )
+        return QSizeF( 0, 0 );
+
+    m_data->updateIgnored();
+
+    const auto constrained = m_data->constrainedOrientation();
+
+    if ( constrained == Qt::Vertical && constraint.width() >= 0.0 )
+    {
+        m_data->setupRows( Qt::Horizontal, false );
+        m_data->layoutRows( Qt::Horizontal, 0.0, constraint.width() );
+        m_data->setupRows( Qt::Vertical, true );
+
+        return QSizeF( constraint.width(), m_data->totalHint( Qt::Vertical, which ) );
+    }
+
+    if ( constrained == Qt::Horizontal && constraint.height() >= 0.0 )
+    {
+        m_data->setupRows( Qt::Vertical, false );
+        m_data->layoutRows( Qt::Vertical, 0.0, constraint.height() );
+        m_data->setupRows( Qt::Horizontal, true );
+
+        return QSizeF( m_data->totalHint( Qt::Horizontal, which ), constraint.height() );
+    }
+
+    m_data->setupRows( Qt::Horizontal, false );
+    m_data->setupRows( Qt::Vertical, false );
+
+    return QSizeF( m_data->totalHint( Qt::Horizontal, which ),
+        m_data->totalHint( Qt::Vertical, which ) );
+}
+
+void QskLayoutEngine::setSpacing( qreal spacing, Qt::Orientations orientations )
+{
+    if ( orientations & Qt::Horizontal )
+        m_data->settings( Qt::Horizontal ).spacing = spacing;
+
+    if ( orientations & Qt::Vertical )
+        m_data->settings( Qt::Vertical ).spacing = spacing;
 }
 
 qreal QskLayoutEngine::spacing( Qt::Orientation orientation ) const
 {
-    const LayoutStyleInfo styleInfo;
-    return QGridLayoutEngine::spacing( orientation, &styleInfo );
+    return m_data->settings( orientation ).spacing;
+}
+
+qreal QskLayoutEngine::defaultSpacing( Qt::Orientation )
+{
+    // later from the theme !!
+    return 5.0;
+}
+
+void QskLayoutEngine::setRowSpacing(
+    int row, qreal spacing, Qt::Orientation orientation )
+{
+    if ( row < 0 )
+        return;
+
+    auto& settings = m_data->settings( orientation );
+
+    qskValueRef( settings.spacings, row, -1.0 ) = spacing;
+    settings.expand( row + 1 );
+}
+
+qreal QskLayoutEngine::rowSpacing( int row, Qt::Orientation orientation ) const
+{
+    const auto& settings = m_data->settings( orientation );
+
+    const qreal spacing = qskValueAt( settings.spacings, row, -1.0 );
+    return ( spacing >= 0.0 ) ? spacing : settings.spacing;
+}
+
+void QskLayoutEngine::setRowStretchFactor(
+    int row, int stretch, Qt::Orientation orientation )
+{
+    if ( row < 0 )
+        return;
+
+    auto& settings = m_data->settings( orientation );
+
+    qskValueRef( settings.stretches, row, -1 ) = stretch;
+    settings.expand( row + 1 );
+}
+
+int QskLayoutEngine::rowStretchFactor( int row, Qt::Orientation orientation ) const
+{
+    const auto& settings = m_data->settings( orientation );
+    return qMax( qskValueAt( settings.stretches, row, -1 ), 0 );
+}
+
+void QskLayoutEngine::setRowSizeHint( Qt::SizeHint which,
+    int row, qreal size, Qt::Orientation orientation )
+{
+    if ( row < 0 || which < Qt::MinimumSize || which > Qt::MaximumSize )
+        return;
+
+    auto& settings = m_data->settings( orientation );
+
+    qskValueRef( settings.hints, row, Settings::defaultHint() ).setValue( which, size );
+    settings.expand( row + 1 );
+}
+
+qreal QskLayoutEngine::rowSizeHint(
+    Qt::SizeHint which, int row, Qt::Orientation orientation ) const
+{
+    return m_data->settings( orientation ).hint( row ).value( which );
+}
+
+void QskLayoutEngine::setRowAlignment(
+    int row, Qt::Alignment alignment, Qt::Orientation orientation )
+{
+    if ( row < 0 )
+        return;
+
+    auto& settings = m_data->settings( orientation );
+
+    qskValueRef( settings.alignments, row, 0 ) = static_cast< int >( alignment );
+    settings.expand( row + 1 );
+
+    // the alignments do not change the rows, but the geometries of the items
+    m_data->markAllDirty();
+}
+
+Qt::Alignment QskLayoutEngine::rowAlignment( int row, Qt::Orientation orientation ) const
+{
+    const auto& settings = m_data->settings( orientation );
+    return static_cast< Qt::Alignment >( qskValueAt( settings.alignments, row, 0 ) );
+}
+
+void QskLayoutEngine::setStaticTracks( const QVector< qreal >& tracks,
+    Qt::SizeMode mode, Qt::Orientation orientation )
+{
+    auto& settings = m_data->settings( orientation );
+
+    settings.tracks.assign( tracks.constBegin(), tracks.constEnd() );
+    settings.trackMode = mode;
+
+    m_data->invalidateCells();
+}
+
+QVector< qreal > QskLayoutEngine::staticTracks( Qt::Orientation orientation ) const
+{
+    const auto& tracks = m_data->settings( orientation ).tracks;
+
+    QVector< qreal > values;
+    values.reserve( static_cast< int >( tracks.size() ) );
+
+    for ( const auto track : tracks )
+        values += track;
+
+    return values;
+}
+
+int QskLayoutEngine::staticTrackCount( Qt::Orientation orientation ) const
+{
+    return static_cast< int >( m_data->settings( orientation ).tracks.size() );
+}
+
+Qt::SizeMode QskLayoutEngine::staticTrackMode( Qt::Orientation orientation ) const
+{
+    return m_data->settings( orientation ).trackMode;
 }
 
-qreal QskLayoutEngine::defaultSpacing( Qt::Orientation orientation )
+bool QskLayoutEngine::hasStaticTracks( Qt::Orientation orientation ) const
 {
-    return LayoutStyleInfo().spacing( orientation );
+    return m_data->settings( orientation ).isStatic();
 }
 
-#if 1
-// QGridLayout or here ???
 QSize QskLayoutEngine::requiredCells() const
 {
+    m_data->updateIgnored();
+
     int lastRow = -1;
     int lastColumn = -1;
 
@@ -219,6 +1659,3 @@ void QskLayoutEngine::adjustSpans( int numRows, int numColumns )
             l->setRowSpan( numRows - l->firstRow(), Qt::Vertical );
     }
 }
-
-#endif
-
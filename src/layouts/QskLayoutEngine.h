@@ -8,28 +8,56 @@
 
 #include "QskGlobal.h"
 
-QSK_QT_PRIVATE_BEGIN
-/*
-    QskLayoutEngine.h should be hidden into some cpp file
-    as it needs private headers. TODO
- */
-
-#include <private/qgridlayoutengine_p.h>
-QSK_QT_PRIVATE_END
+#include <QRectF>
+#include <QSizeF>
+#include <QVector>
 
+#include <memory>
 
 class QskLayoutItem;
 class QQuickItem;
 
-class QskLayoutEngine : public QGridLayoutEngine
+/*
+    A grid of rows and columns, where the items are positioned
+    according to their size hints, policies and stretch factors.
+
+    All calculations work on flat arrays of rows/columns, and the
+    hints of the items are cached until invalidate() is called.
+
+    Compared to QGridLayoutEngine there is no support for baselines:
+    Qt::AlignBaseline is treated like Qt::AlignTop.
+ */
+class QskLayoutEngine
 {
 public:
     QskLayoutEngine();
-    virtual ~QskLayoutEngine();
+    ~QskLayoutEngine();
 
     void setGeometries( const QRectF );
+    void invalidate();
+
+    /*
+        Invalidating the hints of one item and the aggregated
+        hints of its rows and columns only
+     */
+    void invalidateItem( QskLayoutItem* );
+
+    /*
+        setGeometries() split into a calculation, that does not touch
+        the items, and assigning the results. The calculation can be done
+        in another thread, when prefetchHints() has returned true.
+     */
+    bool prefetchHints() const;
+    void calculateGeometries( const QRectF& ) const;
+    void applyGeometries();
+
+    void setVisualDirection( Qt::LayoutDirection );
+    Qt::LayoutDirection visualDirection() const;
+
+    int itemCount() const;
 
     void insertLayoutItem( QskLayoutItem* item, int index );
+    void removeItem( QskLayoutItem* );
 
     QskLayoutItem* layoutItemAt( int index ) const;
     QskLayoutItem* layoutItemAt( int row, int column ) const;
@@ -40,20 +68,66 @@ public:
     QskLayoutItem* layoutItemOf( const QQuickItem* ) const;
     int indexOf( const QQuickItem* item ) const;
 
+    int rowCount() const;
+    int columnCount() const;
+
+    int rowCount( Qt::Orientation ) const;
+    int effectiveLastRow( Qt::Orientation ) const;
+
+    void removeRows( int row, int count, Qt::Orientation );
+
     QSizeF sizeHint( Qt::SizeHint, const QSizeF& constraint = QSizeF() ) const;
 
+    void setSpacing( qreal spacing, Qt::Orientations );
     qreal spacing( Qt::Orientation ) const;
     static qreal defaultSpacing( Qt::Orientation );
 
-#if 1
+    void setRowSpacing( int row, qreal spacing, Qt::Orientation );
+    qreal rowSpacing( int row, Qt::Orientation ) const;
+
+    void setRowStretchFactor( int row, int stretch, Qt::Orientation );
+    int rowStretchFactor( int row, Qt::Orientation ) const;
+
+    void setRowSizeHint( Qt::SizeHint, int row, qreal size, Qt::Orientation );
+    qreal rowSizeHint( Qt::SizeHint, int row, Qt::Orientation ) const;
+
+    void setRowAlignment( int row, Qt::Alignment, Qt::Orientation );
+    Qt::Alignment rowAlignment( int row, Qt::Orientation ) const;
+
+    /*
+        Static tracks replace the rows, that are calculated from the items.
+        The sizes are in pixels ( Qt::AbsoluteSize ) or fractions of the space
+        being left after subtracting the spacings ( Qt::RelativeSize ).
+        Items are stretched to their cells without asking for any hints.
+     */
+    void setStaticTracks( const QVector< qreal >&, Qt::SizeMode, Qt::Orientation );
+    QVector< qreal > staticTracks( Qt::Orientation ) const;
+    int staticTrackCount( Qt::Orientation ) const;
+    Qt::SizeMode staticTrackMode( Qt::Orientation ) const;
+    bool hasStaticTracks( Qt::Orientation ) const;
+
     QSize requiredCells() const;
     void adjustSpans( int numRows, int numColumns );
-#endif
+
+private:
+    Q_DISABLE_COPY( QskLayoutEngine )
+
+    // QskLayoutItem reports changes of its cells and stretch factors
+    friend class QskLayoutItem;
+    void itemChanged( const QskLayoutItem*, bool cellsChanged );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
 };
 
-inline QskLayoutItem* QskLayoutEngine::layoutItemOf( const QQuickItem* item ) const
+inline int QskLayoutEngine::rowCount() const
+{
+    return rowCount( Qt::Vertical );
+}
+
+inline int QskLayoutEngine::columnCount() const
 {
-    return layoutItemAt( indexOf( item ) );
+    return rowCount( Qt::Horizontal );
 }
 
 #endif
@@ -4,41 +4,142 @@
  *****************************************************************************/
 
 #include "QskLayoutItem.h"
+#include "QskLayoutEngine.h"
 #include "QskControl.h"
 #include "QskLayoutConstraint.h"
 
 #include <QQuickItem>
+#include <QtMath>
+
+extern void qskCountConstraintCacheHit();
+
+static inline void qskAdjustHints( QskSizePolicy::Policy policy,
+    qreal& minimum, qreal& preferred, qreal& maximum )
+{
+    if ( !( policy & QskSizePolicy::ShrinkFlag ) )
+        minimum = preferred;
+
+    minimum = qCeil( minimum );
+
+    if ( !( policy & ( QskSizePolicy::GrowFlag | QskSizePolicy::ExpandFlag ) ) )
+        maximum = preferred;
+
+    if ( policy & QskSizePolicy::IgnoreFlag )
+        preferred = minimum;
+
+    maximum = qMax( maximum, minimum );
+    preferred = qBound( minimum, preferred, maximum );
+}
 
 QskLayoutItem::QskLayoutItem( QQuickItem* item,
         int row, int column, int rowSpan, int columnSpan ):
-    Inherited( row, column, qMax( rowSpan, 1 ), qMax( columnSpan, 1 ), Qt::Alignment() ),
     m_isGeometryDirty( false ),
     m_isStretchable( false ),
     m_retainSizeWhenHidden( false ),
+    m_isIgnored( false ),
     m_unlimitedRowSpan( rowSpan <= 0 ),
     m_unlimitedColumnSpan( columnSpan <= 0 ),
     m_updateMode( UpdateWhenVisible ),
-    m_item( item )
+    m_hasCache( false ),
+    m_hasDynamicConstraint( false ),
+    m_isHeightForWidth( true ),
+    m_cachedConstraintCount( 0 ),
+    m_nextCachedConstraint( 0 ),
+    m_item( item ),
+    m_engine( nullptr ),
+    m_index( -1 )
 {
+    m_firstRows[ 0 ] = column;
+    m_firstRows[ 1 ] = row;
+
+    m_rowSpans[ 0 ] = qMax( columnSpan, 1 );
+    m_rowSpans[ 1 ] = qMax( rowSpan, 1 );
+
+    m_stretches[ 0 ] = m_stretches[ 1 ] = -1;
 }
 
 QskLayoutItem::QskLayoutItem( const QSizeF& size, int stretch, int row, int column ):
-    Inherited( row, column, 1, 1, Qt::Alignment() ),
     m_isGeometryDirty( false ),
     m_isStretchable( stretch > 0 ),
     m_retainSizeWhenHidden( false ),
+    m_isIgnored( false ),
     m_unlimitedRowSpan( false ),
     m_unlimitedColumnSpan( false ),
     m_updateMode( UpdateWhenVisible ),
+    m_hasCache( false ),
+    m_hasDynamicConstraint( false ),
+    m_isHeightForWidth( true ),
     m_spacingHint( size ),
-    m_item( nullptr )
+    m_cachedConstraintCount( 0 ),
+    m_nextCachedConstraint( 0 ),
+    m_item( nullptr ),
+    m_engine( nullptr ),
+    m_index( -1 )
 {
+    m_firstRows[ 0 ] = column;
+    m_firstRows[ 1 ] = row;
+
+    m_rowSpans[ 0 ] = m_rowSpans[ 1 ] = 1;
+    m_stretches[ 0 ] = m_stretches[ 1 ] = -1;
 }
 
 QskLayoutItem::~QskLayoutItem()
 {
 }
 
+void QskLayoutItem::notifyEngine( bool cellsChanged )
+{
+    if ( m_engine )
+        m_engine->itemChanged( this, cellsChanged );
+}
+
+void QskLayoutItem::setFirstRow( int row, Qt::Orientation orientation )
+{
+    m_firstRows[ orientation == Qt::Vertical ] = qMax( row, 0 );
+    notifyEngine( true );
+}
+
+void QskLayoutItem::setRowSpan( int span, Qt::Orientation orientation )
+{
+    m_rowSpans[ orientation == Qt::Vertical ] = qMax( span, 1 );
+    notifyEngine( true );
+}
+
+int QskLayoutItem::stretchFactor( Qt::Orientation orientation ) const
+{
+    const int stretch = m_stretches[ orientation == Qt::Vertical ];
+    if ( stretch >= 0 )
+        return stretch;
+
+    const auto policy = sizePolicy( orientation );
+
+    /*
+        Without an explicit stretch factor expanding items are
+        stretched like having a factor of 1. QGridLayoutEngine
+        did not stretch them, but preferred them, when distributing
+        the extra space.
+     */
+    if ( policy & QskSizePolicy::ExpandFlag )
+        return 1;
+
+    if ( policy & QskSizePolicy::GrowFlag )
+        return -1;
+
+    return 0;
+}
+
+void QskLayoutItem::setStretchFactor( int stretch, Qt::Orientation orientation )
+{
+    m_stretches[ orientation == Qt::Vertical ] = stretch;
+    notifyEngine( false );
+}
+
+void QskLayoutItem::setAlignment( Qt::Alignment alignment )
+{
+    m_alignment = alignment;
+    notifyEngine( false );
+}
+
 QskLayoutItem::UpdateMode QskLayoutItem::updateMode() const
 {
     return m_updateMode;
@@ -57,6 +158,9 @@ bool QskLayoutItem::retainSizeWhenHidden() const
 void QskLayoutItem::setRetainSizeWhenHidden( bool on )
 {
     m_retainSizeWhenHidden = on;
+
+    updateIgnored();
+    notifyEngine( false );
 }
 
 QSizeF QskLayoutItem::spacingHint() const
@@ -67,6 +171,9 @@ QSizeF QskLayoutItem::spacingHint() const
 void QskLayoutItem::setSpacingHint( const QSizeF& hint )
 {
     m_spacingHint = hint;
+
+    invalidate();
+    notifyEngine( false );
 }
 
 QSizeF QskLayoutItem::sizeHint(
@@ -86,9 +193,24 @@ QSizeF QskLayoutItem::sizeHint(
 
     QSizeF hint( 0, 0 );
 
-    if ( whichHint == Qt::PreferredSize && QskLayoutConstraint::hasDynamicConstraint( m_item ) )
+    if ( whichHint == Qt::PreferredSize && hasDynamicConstraint() )
     {
-        const quint32 growFlags = QLayoutPolicy::GrowFlag | QLayoutPolicy::ExpandFlag;
+        /*
+            heightForWidth/widthForHeight might be expensive - f.e. for
+            texts - and the engine asks for the same constraints
+            several times. So we remember the most recent results.
+         */
+
+        for ( int i = 0; i < m_cachedConstraintCount; i++ )
+        {
+            if ( m_cachedConstraints[ i ] == constraint )
+            {
+                qskCountConstraintCacheHit();
+                return m_cachedConstraintHints[ i ];
+            }
+        }
+
+        const quint32 growFlags = QskSizePolicy::GrowFlag | QskSizePolicy::ExpandFlag;
         hint = QskLayoutConstraint::effectiveConstraint( m_item, whichHint );
 
         if ( constraint.width() > 0 )
@@ -116,6 +238,14 @@ QSizeF QskLayoutItem::sizeHint(
             else
                 hint.setHeight( QskLayoutConstraint::heightForWidth( m_item, hint.width() ) );
         }
+
+        const int index = m_nextCachedConstraint;
+
+        m_cachedConstraints[ index ] = constraint;
+        m_cachedConstraintHints[ index ] = hint;
+
+        m_nextCachedConstraint = ( index + 1 ) % ConstraintCacheSize;
+        m_cachedConstraintCount = qMin( m_cachedConstraintCount + 1, int( ConstraintCacheSize ) );
     }
     else
     {
@@ -125,27 +255,93 @@ QSizeF QskLayoutItem::sizeHint(
     return hint;
 }
 
-QLayoutPolicy::Policy QskLayoutItem::sizePolicy( Qt::Orientation orientation ) const
+QSizeF QskLayoutItem::effectiveSizeHint( Qt::SizeHint whichHint ) const
 {
-    auto policy = QskLayoutConstraint::sizePolicy( m_item ).policy( orientation );
-#if 1
-    if ( ( policy == QskSizePolicy::Preferred ) && m_item )
+    if ( whichHint < Qt::MinimumSize || whichHint > Qt::MaximumSize )
+        return QSizeF( 0, 0 );
+
+    if ( !m_hasCache )
+        updateCache();
+
+    return m_hints[ whichHint ];
+}
+
+void QskLayoutItem::invalidate()
+{
+    m_hasCache = false;
+
+    m_cachedConstraintCount = 0;
+    m_nextCachedConstraint = 0;
+}
+
+void QskLayoutItem::updateCache() const
+{
+    auto policy = QskLayoutConstraint::sizePolicy( m_item );
+
+    if ( m_item )
     {
-        // QskSizePolicy::Preferred without having a preferred size is the default
-        // setting of QskControl - taken from what QWidget does - but this combination
-        // doesn't make much sense. Usually every derived control is supposed
-        // to set specific values, but in case it has been forgotten we better
-        // ignore the preferred size then.
+        /*
+            QskSizePolicy::Preferred without having a preferred size is the default
+            setting of QskControl - taken from what QWidget does - but this combination
+            doesn't make much sense. Usually every derived control is supposed
+            to set specific values, but in case it has been forgotten we better
+            ignore the preferred size then.
+         */
+
+        if ( policy.horizontalPolicy() == QskSizePolicy::Preferred ||
+            policy.verticalPolicy() == QskSizePolicy::Preferred )
+        {
+            const QSizeF hint = QskLayoutConstraint::effectiveConstraint(
+                m_item, Qt::PreferredSize );
+
+            if ( policy.horizontalPolicy() == QskSizePolicy::Preferred
+                && hint.width() <= 0 )
+            {
+                policy.setHorizontalPolicy( QskSizePolicy::Ignored );
+            }
+
+            if ( policy.verticalPolicy() == QskSizePolicy::Preferred
+                && hint.height() <= 0 )
+            {
+                policy.setVerticalPolicy( QskSizePolicy::Ignored );
+            }
+        }
 
-        const QSizeF hint = QskLayoutConstraint::effectiveConstraint( m_item, Qt::PreferredSize );
+        m_hasDynamicConstraint = QskLayoutConstraint::hasDynamicConstraint( m_item );
 
-        const qreal h = ( orientation == Qt::Horizontal ) ? hint.width() : hint.height();
-        if ( h <= 0 )
-            policy = QskSizePolicy::Ignored;
+        m_isHeightForWidth = true;
+        if ( qobject_cast< const QskControl* >( m_item ) )
+            m_isHeightForWidth = policy.horizontalPolicy() != QskSizePolicy::Constrained;
     }
-#endif
+    else
+    {
+        m_hasDynamicConstraint = false;
+        m_isHeightForWidth = true;
+    }
+
+    m_sizePolicy = policy;
+    m_hasCache = true; // sizeHint below needs the policy
+
+    const QSizeF minimum = sizeHint( Qt::MinimumSize );
+    const QSizeF preferred = sizeHint( Qt::PreferredSize );
+    const QSizeF maximum = sizeHint( Qt::MaximumSize );
 
-    return static_cast< QLayoutPolicy::Policy >( policy );
+    qreal w[] = { minimum.width(), preferred.width(), maximum.width() };
+    qskAdjustHints( policy.horizontalPolicy(), w[0], w[1], w[2] );
+
+    qreal h[] = { minimum.height(), preferred.height(), maximum.height() };
+    qskAdjustHints( policy.verticalPolicy(), h[0], h[1], h[2] );
+
+    for ( int i = 0; i < 3; i++ )
+        m_hints[ i ] = QSizeF( w[ i ], h[ i ] );
+}
+
+QskSizePolicy::Policy QskLayoutItem::sizePolicy( Qt::Orientation orientation ) const
+{
+    if ( !m_hasCache )
+        updateCache();
+
+    return m_sizePolicy.policy( orientation );
 }
 
 void QskLayoutItem::setGeometry( const QRectF& rect )
@@ -171,39 +367,42 @@ void QskLayoutItem::setGeometry( const QRectF& rect )
     qskSetItemGeometry( m_item, rect );
 }
 
+bool QskLayoutItem::hasGeometry( const QRectF& rect ) const
+{
+    return ( m_item == nullptr ) || ( qskItemGeometry( m_item ) == rect );
+}
+
 bool QskLayoutItem::hasDynamicConstraint() const
 {
-    if ( m_item )
-        return QskLayoutConstraint::hasDynamicConstraint( m_item );
+    if ( !m_hasCache )
+        updateCache();
 
-    return false;
+    return m_hasDynamicConstraint;
 }
 
 Qt::Orientation QskLayoutItem::dynamicConstraintOrientation() const
 {
-    Qt::Orientation orientation = Qt::Vertical;
+    if ( !m_hasCache )
+        updateCache();
 
-    if ( const QskControl* control = qobject_cast< const QskControl* >( m_item ) )
-    {
-        const QskSizePolicy& policy = control->sizePolicy();
-        if ( policy.horizontalPolicy() == QskSizePolicy::Constrained )
-            return Qt::Horizontal;
-        else
-            return Qt::Vertical;
-    }
-
-    return orientation;
+    return m_isHeightForWidth ? Qt::Vertical : Qt::Horizontal;
 }
 
 bool QskLayoutItem::isIgnored() const
 {
-    if ( m_item && !m_item->isVisible() )
-        return !m_retainSizeWhenHidden;
-
-    return false;
+    return m_isIgnored;
 }
 
-QLayoutPolicy::ControlTypes QskLayoutItem::controlTypes( LayoutSide side ) const
+bool QskLayoutItem::updateIgnored()
 {
-    return Inherited::controlTypes( side );
+    bool isIgnored = false;
+
+    if ( m_item && !m_item->isVisible() )
+        isIgnored = !m_retainSizeWhenHidden;
+
+    if ( isIgnored == m_isIgnored )
+        return false;
+
+    m_isIgnored = isIgnored;
+    return true;
 }
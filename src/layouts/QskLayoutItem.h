@@ -9,21 +9,14 @@
 #include "QskGlobal.h"
 #include "QskSizePolicy.h"
 
-QSK_QT_PRIVATE_BEGIN
-/*
-    QskLayoutItem.h should be hidden into some cpp file
-    as it needs private headers. TODO
- */
-
-#include <private/qgridlayoutengine_p.h>
-QSK_QT_PRIVATE_END
+#include <QSizeF>
 
 class QQuickItem;
+class QRectF;
+class QskLayoutEngine;
 
-class QskLayoutItem : public QGridLayoutItem
+class QskLayoutItem
 {
-    using Inherited = QGridLayoutItem;
-
 public:
     enum UpdateMode
     {
@@ -42,15 +35,50 @@ public:
     QQuickItem* item();
     const QQuickItem* item() const;
 
-    virtual QLayoutPolicy::Policy sizePolicy( Qt::Orientation ) const override final;
-    virtual QSizeF sizeHint( Qt::SizeHint, const QSizeF& ) const override final;
-    virtual void setGeometry( const QRectF& ) override final;
+    int firstRow( Qt::Orientation = Qt::Vertical ) const;
+    void setFirstRow( int row, Qt::Orientation = Qt::Vertical );
+
+    int lastRow( Qt::Orientation = Qt::Vertical ) const;
+
+    int rowSpan( Qt::Orientation = Qt::Vertical ) const;
+    void setRowSpan( int span, Qt::Orientation = Qt::Vertical );
+
+    int firstColumn() const;
+    int lastColumn() const;
+    int columnSpan() const;
+
+    int stretchFactor( Qt::Orientation ) const;
+    void setStretchFactor( int stretch, Qt::Orientation );
+
+    Qt::Alignment alignment() const;
+    void setAlignment( Qt::Alignment );
+
+    QskSizePolicy::Policy sizePolicy( Qt::Orientation ) const;
+    QSizeF sizeHint( Qt::SizeHint, const QSizeF& constraint = QSizeF() ) const;
+
+    /*
+        The hints adjusted to the size policy, like they are used
+        by the layout engine. The values are cached until invalidate(),
+        what also drops the memoized results of heightForWidth/widthForHeight.
+     */
+    QSizeF effectiveSizeHint( Qt::SizeHint ) const;
+    void invalidate();
+
+    void setGeometry( const QRectF& );
 
-    virtual bool hasDynamicConstraint() const override final;
-    virtual Qt::Orientation dynamicConstraintOrientation() const override final;
+    // true, when the item has this geometry
+    bool hasGeometry( const QRectF& ) const;
 
-    virtual bool isIgnored() const override final;
-    virtual QLayoutPolicy::ControlTypes controlTypes( LayoutSide side ) const override final;
+    bool hasDynamicConstraint() const;
+    Qt::Orientation dynamicConstraintOrientation() const;
+
+    /*
+        Hidden items are ignored, unless retainSizeWhenHidden() is set.
+        The visibility is read by updateIgnored() - what has to be done
+        in the GUI thread - so that isIgnored() is thread safe.
+     */
+    bool isIgnored() const;
+    bool updateIgnored(); // returns true, when the state has changed
 
     bool retainSizeWhenHidden() const;
     void setRetainSizeWhenHidden( bool on );
@@ -67,16 +95,46 @@ public:
     bool hasUnlimitedSpan( Qt::Orientation orientation ) const;
 
 private:
+    void updateCache() const;
+    void notifyEngine( bool cellsChanged );
+
+    enum { ConstraintCacheSize = 4 };
+
     bool m_isGeometryDirty : 1;
     bool m_isStretchable : 1;
     bool m_retainSizeWhenHidden : 1;
+    bool m_isIgnored : 1;
     bool m_unlimitedRowSpan : 1;
     bool m_unlimitedColumnSpan : 1;
     UpdateMode m_updateMode : 2;
 
+    mutable bool m_hasCache : 1;
+    mutable bool m_hasDynamicConstraint : 1;
+    mutable bool m_isHeightForWidth : 1;
+
+    int m_firstRows[ 2 ];
+    int m_rowSpans[ 2 ];
+    int m_stretches[ 2 ];
+
+    Qt::Alignment m_alignment;
+
     QSizeF m_spacingHint;
 
+    mutable QskSizePolicy m_sizePolicy;
+    mutable QSizeF m_hints[ 3 ];
+
+    // memoized results of sizeHint( Qt::PreferredSize, constraint )
+    mutable int m_cachedConstraintCount;
+    mutable int m_nextCachedConstraint;
+    mutable QSizeF m_cachedConstraints[ ConstraintCacheSize ];
+    mutable QSizeF m_cachedConstraintHints[ ConstraintCacheSize ];
+
     QQuickItem* m_item;
+
+    // the engine, the item has been inserted to, and its index there
+    friend class QskLayoutEngine;
+    QskLayoutEngine* m_engine;
+    int m_index;
 };
 
 inline QQuickItem* QskLayoutItem::item()
@@ -89,6 +147,42 @@ inline const QQuickItem* QskLayoutItem::item() const
     return m_item;
 }
 
+inline int QskLayoutItem::firstRow( Qt::Orientation orientation ) const
+{
+    return m_firstRows[ orientation == Qt::Vertical ];
+}
+
+inline int QskLayoutItem::lastRow( Qt::Orientation orientation ) const
+{
+    const int i = ( orientation == Qt::Vertical );
+    return m_firstRows[ i ] + m_rowSpans[ i ] - 1;
+}
+
+inline int QskLayoutItem::rowSpan( Qt::Orientation orientation ) const
+{
+    return m_rowSpans[ orientation == Qt::Vertical ];
+}
+
+inline int QskLayoutItem::firstColumn() const
+{
+    return firstRow( Qt::Horizontal );
+}
+
+inline int QskLayoutItem::lastColumn() const
+{
+    return lastRow( Qt::Horizontal );
+}
+
+inline int QskLayoutItem::columnSpan() const
+{
+    return rowSpan( Qt::Horizontal );
+}
+
+inline Qt::Alignment QskLayoutItem::alignment() const
+{
+    return m_alignment;
+}
+
 inline bool QskLayoutItem::isGeometryDirty() const
 {
     return m_isGeometryDirty;
@@ -57,7 +57,7 @@ void QskLinearBox::setDimension( uint dimension )
         m_data->dimension = dimension;
 
         rearrange();
-        polish();
+        activate();
     }
 }
 
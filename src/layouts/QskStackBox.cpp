@@ -279,15 +279,10 @@ void QskStackBox::layoutItemInserted( QskLayoutItem* layoutItem, int index )
 
 #if 1
     /*
-       In general QGridLayoutEngine supports having multiple entries
-       in one cell, but well ...
-       So we have to go away from using it and doing the simple use case of
-       a stack layout manually. TODO ...
-
-       One problem we ran into is, that a cell is considered being hidden,
-       when the first entry is ignored. So for the moment we simply set the
-       retainSizeWhenHidden flag, with the cost of having geometry updates
-       for invisible updates.
+       All entries share the same cell, and the size of the
+       cell should not depend on which of them is visible. So we
+       set the retainSizeWhenHidden flag, with the cost of having
+       geometry updates for invisible items.
      */
     layoutItem->setRetainSizeWhenHidden( true );
 #endif
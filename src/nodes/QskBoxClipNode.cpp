@@ -9,6 +9,16 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskFunctions.h"
 
+#ifdef ITEM_STATISTICS
+
+#include <QAtomicInt>
+
+// nodes are updated from the scene graph thread
+static QAtomicInt qskNodeCount;
+static QAtomicInt qskStencilNodeCount;
+
+#endif
+
 static inline uint qskMetricsHash( const QskBoxShapeMetrics& shape,
     const QskBoxBorderMetrics& border )
 {
@@ -18,15 +28,62 @@ static inline uint qskMetricsHash( const QskBoxShapeMetrics& shape,
     return border.hash( hash );
 }
 
+static inline bool qskIsRectangularFill( const QRectF& rect,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics )
+{
+    if ( shapeMetrics.isRectangle() )
+        return true;
+
+    // radii and widths might be relative to the size
+    const auto shape = shapeMetrics.toAbsolute( rect.size() );
+    const auto border = borderMetrics.toAbsolute( rect.size() );
+
+    /*
+        When the border is wider than the radius of a corner the
+        inner corner is cropped to a right angle. When this happens
+        for all corners the filled area is a plain rectangle.
+     */
+
+    const auto& bw = border.widths();
+
+    const QSizeF r1 = shape.radius( Qt::TopLeftCorner );
+    if ( r1.width() > bw.left() && r1.height() > bw.top() )
+        return false;
+
+    const QSizeF r2 = shape.radius( Qt::TopRightCorner );
+    if ( r2.width() > bw.right() && r2.height() > bw.top() )
+        return false;
+
+    const QSizeF r3 = shape.radius( Qt::BottomLeftCorner );
+    if ( r3.width() > bw.left() && r3.height() > bw.bottom() )
+        return false;
+
+    const QSizeF r4 = shape.radius( Qt::BottomRightCorner );
+    if ( r4.width() > bw.right() && r4.height() > bw.bottom() )
+        return false;
+
+    return true;
+}
+
 QskBoxClipNode::QskBoxClipNode():
     m_hash( 0 ),
     m_geometry( QSGGeometry::defaultAttributes_Point2D(), 0 )
 {
     setGeometry( &m_geometry );
+
+#ifdef ITEM_STATISTICS
+    qskNodeCount.ref();
+#endif
 }
 
 QskBoxClipNode::~QskBoxClipNode()
 {
+#ifdef ITEM_STATISTICS
+    if ( m_geometry.vertexCount() > 0 )
+        qskStencilNodeCount.deref();
+
+    qskNodeCount.deref();
+#endif
 }
 
 void QskBoxClipNode::setBox( const QRectF& rect,
@@ -39,7 +96,18 @@ void QskBoxClipNode::setBox( const QRectF& rect,
     m_rect = rect;
     m_hash = hash;
 
-    if ( shape.isRectangle() )
+#ifdef ITEM_STATISTICS
+    const bool hadStencil = m_geometry.vertexCount() > 0;
+#endif
+
+    /*
+        A rectangular clip can be done with the scissor test, while
+        anything else needs a stencil pass and breaks batching
+        of the clipped nodes. So we use the geometry only when
+        the clip is really not a rectangle.
+     */
+
+    if ( qskIsRectangularFill( rect, shape, border ) )
     {
         if ( m_geometry.vertexCount() > 0 )
             m_geometry.allocate( 0 );
@@ -56,7 +124,33 @@ void QskBoxClipNode::setBox( const QRectF& rect,
         Even in situations, where the clipping is not rectangular, it is
         useful to know its bounding rectangle
      */
-    setClipRect( qskValidOrEmptyInnerRect( rect, border.widths() ) );
+    const auto borderWidths = border.toAbsolute( rect.size() ).widths();
+    setClipRect( qskValidOrEmptyInnerRect( rect, borderWidths ) );
+
+#ifdef ITEM_STATISTICS
+    const bool hasStencil = m_geometry.vertexCount() > 0;
+    if ( hasStencil != hadStencil )
+    {
+        if ( hasStencil )
+            qskStencilNodeCount.ref();
+        else
+            qskStencilNodeCount.deref();
+    }
+#endif
 
     markDirty( QSGNode::DirtyGeometry );
 }
+
+#ifdef ITEM_STATISTICS
+
+int QskBoxClipNode::nodeCount()
+{
+    return qskNodeCount.load();
+}
+
+int QskBoxClipNode::stencilNodeCount()
+{
+    return qskStencilNodeCount.load();
+}
+
+#endif
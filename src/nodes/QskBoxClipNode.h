@@ -21,6 +21,12 @@ public:
     void setBox( const QRectF&,
         const QskBoxShapeMetrics&, const QskBoxBorderMetrics& );
 
+#ifdef ITEM_STATISTICS
+    // statistics, f.e. for counting the clips, that need a stencil pass
+    static int nodeCount();
+    static int stencilNodeCount();
+#endif
+
 private:
     uint m_hash;
     QRectF m_rect;
@@ -9,13 +9,217 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxBorderColors.h"
 #include "QskGradient.h"
+#include "QskObjectCounter.h"
 
 #include <QSGVertexColorMaterial>
 #include <QSGFlatColorMaterial>
+#include <QSGMaterialShader>
+#include <QVector4D>
 #include <QGlobalStatic>
+#include <QAtomicInt>
+#include <QThreadStorage>
 
 Q_GLOBAL_STATIC( QSGVertexColorMaterial, qskMaterialVertex )
 
+static QskBoxNode::MaterialMode qskMaterialMode = QskBoxNode::VertexColorMaterial;
+static int qskAutoMaterialThreshold = 100;
+static bool qskCompactVertexes = false;
+
+/*
+    Nodes are updated from the scene graph thread, what might be
+    more than one, when having several windows
+ */
+static QAtomicInt qskNodeCount;
+static QAtomicInt qskFlatNodeCount;
+static QAtomicInt qskCompactNodeCount;
+static QAtomicInteger< quint64 > qskVertexBytes;
+
+static inline bool qskUseFlatMaterial()
+{
+    switch( qskMaterialMode )
+    {
+        case QskBoxNode::FlatColorWhenMonochrome:
+            return true;
+
+        case QskBoxNode::AutoMaterial:
+            return qskNodeCount.load() <= qskAutoMaterialThreshold;
+
+        default:
+            return false;
+    }
+}
+
+namespace
+{
+    class CompactPoint2D
+    {
+    public:
+        qint16 x, y;
+        unsigned char r, g, b, a;
+    };
+
+    const QSGGeometry::AttributeSet& compactAttributes()
+    {
+        static QSGGeometry::Attribute attributes[] =
+        {
+            QSGGeometry::Attribute::create( 0, 2, GL_SHORT, true ),
+            QSGGeometry::Attribute::create( 1, 4, GL_UNSIGNED_BYTE, false )
+        };
+
+        static QSGGeometry::AttributeSet attributeSet =
+            { 2, sizeof( CompactPoint2D ), attributes };
+
+        return attributeSet;
+    }
+
+    class CompactMaterialShader final : public QSGMaterialShader
+    {
+    public:
+        virtual char const* const* attributeNames() const override final;
+        virtual void updateState( const RenderState&,
+            QSGMaterial*, QSGMaterial* ) override final;
+
+    protected:
+        virtual void initialize() override final;
+
+        virtual const char* vertexShader() const override final;
+        virtual const char* fragmentShader() const override final;
+
+    private:
+        int m_matrixId;
+        int m_opacityId;
+        int m_frameId;
+    };
+
+    class CompactMaterial final : public QSGMaterial
+    {
+    public:
+        CompactMaterial();
+
+        virtual QSGMaterialType* type() const override;
+        virtual QSGMaterialShader* createShader() const override;
+
+        virtual int compare( const QSGMaterial* ) const override;
+
+        /*
+            The positions are normalized by the renderer to [-1, 1]:
+            frame.xy is the center of the box, frame.zw half of its size
+         */
+        QVector4D frame;
+    };
+
+    char const* const* CompactMaterialShader::attributeNames() const
+    {
+        static char const* const attr[] = { "vertexCoord", "vertexColor", 0 };
+        return attr;
+    }
+
+    void CompactMaterialShader::updateState( const RenderState& state,
+        QSGMaterial* newMaterial, QSGMaterial* oldMaterial )
+    {
+        if ( state.isOpacityDirty() )
+            program()->setUniformValue( m_opacityId, state.opacity() );
+
+        if ( state.isMatrixDirty() )
+            program()->setUniformValue( m_matrixId, state.combinedMatrix() );
+
+        auto materialOld = static_cast< CompactMaterial* >( oldMaterial );
+        auto materialNew = static_cast< CompactMaterial* >( newMaterial );
+
+        if ( ( materialOld == nullptr ) || ( materialOld->frame != materialNew->frame ) )
+            program()->setUniformValue( m_frameId, materialNew->frame );
+    }
+
+    void CompactMaterialShader::initialize()
+    {
+        m_matrixId = program()->uniformLocation( "matrix" );
+        m_opacityId = program()->uniformLocation( "opacity" );
+        m_frameId = program()->uniformLocation( "frame" );
+    }
+
+    const char* CompactMaterialShader::vertexShader() const
+    {
+        return
+            "attribute highp vec4 vertexCoord;\n"
+            "attribute lowp vec4 vertexColor;\n"
+            "uniform highp mat4 matrix;\n"
+            "uniform highp vec4 frame;\n"
+            "uniform lowp float opacity;\n"
+            "varying lowp vec4 color;\n"
+            "void main()\n"
+            "{\n"
+            "    color = vertexColor * opacity;\n"
+            "    gl_Position = matrix * vec4( frame.xy + vertexCoord.xy * frame.zw, 0.0, 1.0 );\n"
+            "}";
+    }
+
+    const char* CompactMaterialShader::fragmentShader() const
+    {
+        return
+            "varying lowp vec4 color;\n"
+            "void main()\n"
+            "{\n"
+            "    gl_FragColor = color;\n"
+            "}";
+    }
+
+    CompactMaterial::CompactMaterial()
+    {
+        setFlag( Blending, true );
+    }
+
+    QSGMaterialType* CompactMaterial::type() const
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    QSGMaterialShader* CompactMaterial::createShader() const
+    {
+        return new CompactMaterialShader();
+    }
+
+    int CompactMaterial::compare( const QSGMaterial* other ) const
+    {
+        const auto& f1 = frame;
+        const auto& f2 = static_cast< const CompactMaterial* >( other )->frame;
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            if ( f1[ i ] != f2[ i ] )
+                return ( f1[ i ] > f2[ i ] ) ? 1 : -1;
+        }
+
+        return 0;
+    }
+}
+
+static inline qint16 qskCompactValue( float value, float center, float halfSize )
+{
+    const float v = ( value - center ) / halfSize;
+    return static_cast< qint16 >( qRound( qBound( -1.0f, v, 1.0f ) * 32767.0f ) );
+}
+
+/*
+    The box renderers produce colored float vertexes, that are converted
+    for the compact mode. Instead of allocating an intermediate geometry
+    for each update we reuse a scratch geometry of the render thread.
+    As QSGGeometry::allocate keeps the memory, when the number of vertexes
+    does not change, resizing a box does not allocate at all.
+ */
+static QSGGeometry* qskScratchGeometry()
+{
+    static QThreadStorage< QSGGeometry* > storage;
+
+    if ( !storage.hasLocalData() )
+    {
+        storage.setLocalData( new QSGGeometry(
+            QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 ) );
+    }
+
+    return storage.localData();
+}
+
 static inline uint qskMetricsHash( const QskBoxShapeMetrics& shape,
     const QskBoxBorderMetrics& borderMetrics )
 {
@@ -36,16 +240,33 @@ static inline uint qskColorsHash( const QskBoxBorderColors& borderColors,
 QskBoxNode::QskBoxNode():
     m_metricsHash( 0 ),
     m_colorsHash( 0 ),
+    m_estimatedBytes( 0 ),
     m_geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 )
 {
     setMaterial( qskMaterialVertex );
     setGeometry( &m_geometry );
+
+    qskNodeCount.ref();
+    QskObjectCounter::countNode( QskObjectCounter::BoxNode, 1 );
 }
 
 QskBoxNode::~QskBoxNode()
 {
     if ( material() != qskMaterialVertex )
+    {
+        // a compact geometry is deleted by QSGGeometryNode
+        if ( geometry() != &m_geometry )
+            qskCompactNodeCount.deref();
+        else
+            qskFlatNodeCount.deref();
+
         delete material();
+    }
+
+    qskNodeCount.deref();
+
+    QskObjectCounter::countNode( QskObjectCounter::BoxNode, -1 );
+    QskObjectCounter::countNodeBytes( QskObjectCounter::BoxNode, -m_estimatedBytes );
 }
 
 void QskBoxNode::setBoxData( const QRectF& rect, const QskGradient& fillGradient )
@@ -78,7 +299,9 @@ void QskBoxNode::setBoxData( const QRectF& rect,
 
     if ( rect.isEmpty() )
     {
-        m_geometry.allocate( 0 );
+        geometry()->allocate( 0 );
+        updateEstimatedBytes();
+
         return;
     }
 
@@ -97,7 +320,9 @@ void QskBoxNode::setBoxData( const QRectF& rect,
 
     if ( !hasBorder && !hasFill )
     {
-        m_geometry.allocate( 0 );
+        geometry()->allocate( 0 );
+        updateEstimatedBytes();
+
         return;
     }
 
@@ -116,15 +341,15 @@ void QskBoxNode::setBoxData( const QRectF& rect,
         }
     }
 
-    bool maybeFlat = false;
-
     /*
         Always using the same material result in a better batching
-        but wastes some memory. when we have a solid color.
-        Maybe its worth to introduce a flag to control the behaviour,
-        but for the moment we go with performance.
+        but wastes some memory, when we have a solid color.
+        What is preferrable depends on the scene and the renderer,
+        so it can be controlled by the material mode.
      */
 
+    bool maybeFlat = qskUseFlatMaterial();
+
     if ( maybeFlat )
     {
         if ( ( hasFill && hasBorder ) || ( hasFill && !isFillMonochrome )
@@ -136,8 +361,19 @@ void QskBoxNode::setBoxData( const QRectF& rect,
 
     QskBoxRenderer renderer;
 
-    if ( !maybeFlat )
+    if ( !maybeFlat && qskCompactVertexes )
     {
+        setCompact( true );
+
+        auto scratch = qskScratchGeometry();
+        renderer.renderBox( m_rect, shape, borderMetrics,
+            borderColors, fillGradient, *scratch );
+
+        updateCompactGeometry( *scratch );
+    }
+    else if ( !maybeFlat )
+    {
+        setCompact( false );
         setMonochrome( false );
 
         renderer.renderBox( m_rect, shape, borderMetrics,
@@ -146,6 +382,7 @@ void QskBoxNode::setBoxData( const QRectF& rect,
     else
     {
         // all is done with one color
+        setCompact( false );
         setMonochrome( true );
 
         auto* flatMaterial = static_cast< QSGFlatColorMaterial *>( material() );
@@ -153,7 +390,16 @@ void QskBoxNode::setBoxData( const QRectF& rect,
         if ( hasFill )
         {
             flatMaterial->setColor( fillGradient.startColor() );
-            renderer.renderFill( m_rect, shape, QskBoxBorderMetrics(), *geometry() );
+
+            /*
+                When the border has the color of the fill, we draw one
+                area - otherwise the border is invisible and we have to
+                leave it out.
+             */
+            if ( borderColors.isVisible() )
+                renderer.renderFill( m_rect, shape, QskBoxBorderMetrics(), *geometry() );
+            else
+                renderer.renderFill( m_rect, shape, borderMetrics, *geometry() );
         }
         else
         {
@@ -161,6 +407,68 @@ void QskBoxNode::setBoxData( const QRectF& rect,
             renderer.renderBorder( m_rect, shape, borderMetrics, *geometry() );
         }
     }
+
+    const auto g = geometry();
+    qskVertexBytes.fetchAndAddRelaxed(
+        quint64( g->vertexCount() ) * g->sizeOfVertex() );
+
+    updateEstimatedBytes();
+}
+
+void QskBoxNode::updateEstimatedBytes()
+{
+    const auto g = geometry();
+
+    /*
+        In compact mode m_geometry is always empty and the
+        scratch geometry is shared, so we only have to count
+        the geometry, that is attached to the node.
+     */
+    const int bytes = g->vertexCount() * g->sizeOfVertex();
+
+    if ( bytes != m_estimatedBytes )
+    {
+        QskObjectCounter::countNodeBytes(
+            QskObjectCounter::BoxNode, bytes - m_estimatedBytes );
+
+        m_estimatedBytes = bytes;
+    }
+}
+
+int QskBoxNode::estimatedBytes() const
+{
+    return m_estimatedBytes;
+}
+
+void QskBoxNode::updateCompactGeometry( const QSGGeometry& from )
+{
+    const float cx = m_rect.center().x();
+    const float cy = m_rect.center().y();
+
+    // avoiding divisions by zero for boxes without extent
+    const float hw = qMax( 0.5 * m_rect.width(), 1.0 );
+    const float hh = qMax( 0.5 * m_rect.height(), 1.0 );
+
+    auto compactMaterial = static_cast< CompactMaterial* >( material() );
+    compactMaterial->frame = QVector4D( cx, cy, hw, hh );
+
+    const int count = from.vertexCount();
+
+    auto g = geometry();
+    g->allocate( count );
+
+    const auto p1 = from.vertexDataAsColoredPoint2D();
+    auto p2 = static_cast< CompactPoint2D* >( g->vertexData() );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        p2[ i ].x = qskCompactValue( p1[ i ].x, cx, hw );
+        p2[ i ].y = qskCompactValue( p1[ i ].y, cy, hh );
+        p2[ i ].r = p1[ i ].r;
+        p2[ i ].g = p1[ i ].g;
+        p2[ i ].b = p1[ i ].b;
+        p2[ i ].a = p1[ i ].a;
+    }
 }
 
 void QskBoxNode::setMonochrome( bool on )
@@ -174,6 +482,7 @@ void QskBoxNode::setMonochrome( bool on )
 
     if ( on )
     {
+        qskFlatNodeCount.ref();
         setMaterial( new QSGFlatColorMaterial() );
 
         const QSGGeometry g( QSGGeometry::defaultAttributes_Point2D(), 0 );
@@ -181,6 +490,8 @@ void QskBoxNode::setMonochrome( bool on )
     }
     else
     {
+        qskFlatNodeCount.deref();
+
         setMaterial( qskMaterialVertex );
         delete material;
 
@@ -188,3 +499,94 @@ void QskBoxNode::setMonochrome( bool on )
         memcpy( (void *)&m_geometry, (void *)&g, sizeof( QSGGeometry ) );
     }
 }
+
+void QskBoxNode::setCompact( bool on )
+{
+    const bool isCompact = ( geometry() != &m_geometry );
+    if ( on == isCompact )
+        return;
+
+    if ( on )
+    {
+        // a flat node has to be turned into a vertex colored one first
+        setMonochrome( false );
+        m_geometry.allocate( 0 );
+
+        qskCompactNodeCount.ref();
+
+        setMaterial( new CompactMaterial() );
+        setGeometry( new QSGGeometry( compactAttributes(), 0 ) );
+
+        setFlag( QSGNode::OwnsGeometry, true );
+    }
+    else
+    {
+        qskCompactNodeCount.deref();
+
+        const auto material = this->material();
+        setMaterial( qskMaterialVertex );
+        delete material;
+
+        const auto geometry = this->geometry();
+
+        setFlag( QSGNode::OwnsGeometry, false );
+        setGeometry( &m_geometry );
+
+        delete geometry;
+    }
+}
+
+void QskBoxNode::setMaterialMode( MaterialMode mode )
+{
+    qskMaterialMode = mode;
+}
+
+QskBoxNode::MaterialMode QskBoxNode::materialMode()
+{
+    return qskMaterialMode;
+}
+
+void QskBoxNode::setAutoMaterialThreshold( int nodeCount )
+{
+    qskAutoMaterialThreshold = qMax( nodeCount, 0 );
+}
+
+int QskBoxNode::autoMaterialThreshold()
+{
+    return qskAutoMaterialThreshold;
+}
+
+int QskBoxNode::nodeCount()
+{
+    return qskNodeCount.load();
+}
+
+int QskBoxNode::flatColorNodeCount()
+{
+    return qskFlatNodeCount.load();
+}
+
+int QskBoxNode::compactNodeCount()
+{
+    return qskCompactNodeCount.load();
+}
+
+void QskBoxNode::setCompactVertexes( bool on )
+{
+    qskCompactVertexes = on;
+}
+
+bool QskBoxNode::compactVertexes()
+{
+    return qskCompactVertexes;
+}
+
+quint64 QskBoxNode::uploadedVertexBytes()
+{
+    return qskVertexBytes.load();
+}
+
+void QskBoxNode::resetUploadedVertexBytes()
+{
+    qskVertexBytes.store( 0 );
+}
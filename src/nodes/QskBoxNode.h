@@ -19,6 +19,29 @@ class QRectF;
 class QSK_EXPORT QskBoxNode : public QSGGeometryNode
 {
 public:
+    enum MaterialMode
+    {
+        /*
+            All nodes share the same QSGVertexColorMaterial, what
+            allows the renderer to merge them into one batch
+         */
+        VertexColorMaterial,
+
+        /*
+            Monochrome boxes are drawn with a QSGFlatColorMaterial.
+            The vertexes are smaller, but boxes with different colors
+            can't be merged anymore
+         */
+        FlatColorWhenMonochrome,
+
+        /*
+            FlatColorWhenMonochrome as long as the number of box nodes
+            does not exceed autoMaterialThreshold(), VertexColorMaterial
+            otherwise.
+         */
+        AutoMaterial
+    };
+
     QskBoxNode();
     virtual ~QskBoxNode();
 
@@ -28,13 +51,46 @@ public:
 
     void setBoxData( const QRectF& rect, const QskGradient& );
 
+    // the mode is respected, when the geometry of a node is updated
+    static void setMaterialMode( MaterialMode );
+    static MaterialMode materialMode();
+
+    static void setAutoMaterialThreshold( int nodeCount );
+    static int autoMaterialThreshold();
+
+    /*
+        Boxes with colored vertexes are uploaded with 16 bit integer
+        positions relative to the box, what reduces a vertex from 12
+        to 8 bytes. As the renderer can't merge these nodes into
+        batches, this mode is for setups, where the bandwidth for
+        uploading the vertexes is the bottleneck.
+     */
+    static void setCompactVertexes( bool );
+    static bool compactVertexes();
+
+    // statistics, f.e. for comparing the material modes
+    static int nodeCount();
+    static int flatColorNodeCount();
+    static int compactNodeCount();
+
+    static quint64 uploadedVertexBytes();
+    static void resetUploadedVertexBytes();
+
+    // memory of the vertexes, see QskObjectCounter
+    int estimatedBytes() const;
+
 private:
     void setMonochrome( bool on );
+    void setCompact( bool on );
+    void updateCompactGeometry( const QSGGeometry& );
+    void updateEstimatedBytes();
 
     uint m_metricsHash;
     uint m_colorsHash;
     QRectF m_rect;
 
+    int m_estimatedBytes;
+
     QSGGeometry m_geometry;
 };
 
@@ -1,4 +1,5 @@
 #include "QskGraphicNode.h"
+#include "QskObjectCounter.h"
 
 static inline uint qskHash(
     const QskGraphic& graphic, const QskColorFilter& colorFilter,
@@ -30,12 +31,15 @@ static inline uint qskHash(
 }
 
 QskGraphicNode::QskGraphicNode():
-    m_hash( 0 )
+    m_hash( 0 ),
+    m_estimatedBytes( 0 )
 {
 }
 
 QskGraphicNode::~QskGraphicNode()
 {
+    QskObjectCounter::countNodeBytes(
+        QskObjectCounter::TextureNode, -m_estimatedBytes );
 }
 
 void QskGraphicNode::setGraphic(
@@ -68,5 +72,18 @@ void QskGraphicNode::setGraphic(
             textureRect, Qt::IgnoreAspectRatio, graphic, colorFilter );
 
         QskTextureNode::setTextureId( textureId );
+
+        // RGBA, the old texture has been deleted in setTextureId
+        const int bytes = 4 * textureRect.width() * textureRect.height();
+
+        QskObjectCounter::countNodeBytes(
+            QskObjectCounter::TextureNode, bytes - m_estimatedBytes );
+
+        m_estimatedBytes = bytes;
     }
 }
+
+int QskGraphicNode::estimatedBytes() const
+{
+    return m_estimatedBytes;
+}
@@ -22,11 +22,15 @@ public:
     void setGraphic( const QskGraphic&, const QskColorFilter&,
         QskGraphicTextureFactory::RenderMode, const QRect& );
 
+    // memory of the texture, see QskObjectCounter
+    int estimatedBytes() const;
+
 private:
     void setTextureId( int ) = delete;
     void setRect(const QRectF& ) = delete;
 
     uint m_hash;
+    int m_estimatedBytes;
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include "QskTextOptions.h"
 #include "QskTextColors.h"
 #include "QskTextRenderer.h"
+#include "QskObjectCounter.h"
 
 #include <QFont>
 #include <QColor>
@@ -31,12 +32,16 @@ static inline uint qskHash(
 }
 
 QskTextNode::QskTextNode():
-    m_hash( 0 )
+    m_hash( 0 ),
+    m_glyphNodeCount( 0 )
 {
+    QskObjectCounter::countNode( QskObjectCounter::TextNode, 1 );
 }
 
 QskTextNode::~QskTextNode()
 {
+    QskObjectCounter::countNode( QskObjectCounter::TextNode, -1 );
+    QskObjectCounter::countNode( QskObjectCounter::GlyphNode, -m_glyphNodeCount );
 }
 
 void QskTextNode::setTextData( const QQuickItem* item,
@@ -66,5 +71,13 @@ void QskTextNode::setTextData( const QQuickItem* item,
          */
         QskTextRenderer::updateNode( text, font, options, textStyle,
             colors, alignment, textRect, item, this );
+
+        // the renderers create one child node for each glyph run
+        const int glyphNodeCount = childCount();
+
+        QskObjectCounter::countNode( QskObjectCounter::GlyphNode,
+            glyphNodeCount - m_glyphNodeCount );
+
+        m_glyphNodeCount = glyphNodeCount;
     }
 }
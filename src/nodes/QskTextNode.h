@@ -31,6 +31,7 @@ public:
 
 private:
     uint m_hash;
+    int m_glyphNodeCount;
 };
 
 #endif
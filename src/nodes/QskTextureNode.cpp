@@ -1,4 +1,5 @@
 #include "QskTextureNode.h"
+#include "QskObjectCounter.h"
 
 #include <QSGGeometry>
 #include <QSGMaterial>
@@ -169,12 +170,16 @@ QskTextureNode::QskTextureNode() :
 
     setMaterial( &d->material );
     setOpaqueMaterial( &d->opaqueMaterial );
+
+    QskObjectCounter::countNode( QskObjectCounter::TextureNode, 1 );
 }
 
 QskTextureNode::~QskTextureNode()
 {
     Q_D( QskTextureNode );
 
+    QskObjectCounter::countNode( QskObjectCounter::TextureNode, -1 );
+
     if ( d->material.textureId() > 0 )
     {
         /*
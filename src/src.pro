@@ -130,6 +130,7 @@ HEADERS += \
     controls/QskFlickAnimator.h \
     controls/QskFocusIndicator.h \
     controls/QskFocusIndicatorSkinlet.h \
+    controls/QskFrameProfiler.h \
     controls/QskGesture.h \
     controls/QskGestureRecognizer.h \
     controls/QskGraphicLabel.h \
@@ -182,6 +183,7 @@ HEADERS += \
     controls/QskTextLabel.h \
     controls/QskTextLabelSkinlet.h \
     controls/QskVariantAnimator.h \
+    controls/QskVirtualBox.h \
     controls/QskWindow.h
 
 SOURCES += \
@@ -195,6 +197,7 @@ SOURCES += \
     controls/QskFlickAnimator.cpp \
     controls/QskFocusIndicator.cpp \
     controls/QskFocusIndicatorSkinlet.cpp \
+    controls/QskFrameProfiler.cpp \
     controls/QskGesture.cpp \
     controls/QskGestureRecognizer.cpp \
     controls/QskGraphicLabel.cpp \
@@ -247,6 +250,7 @@ SOURCES += \
     controls/QskTextLabel.cpp \
     controls/QskTextLabelSkinlet.cpp \
     controls/QskVariantAnimator.cpp \
+    controls/QskVirtualBox.cpp \
     controls/QskWindow.cpp
 
 HEADERS += \